@@ -1,259 +1,553 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "AfterburnerController.h"
-#include "../utils/FileSystem.h"
-#include "../utils/WindowsCommon.h"
-
-
-namespace Loader
-{
-
-const std::wstring kConfigName = L"MSIAfterburnerLoader.cfg";
-const std::wstring kConfigSectionMain             = L"Main";
-const std::wstring kConfigKeyStartupProfileDelay  = L"StartupDelay";
-const std::wstring kConfigKeyStartupProfileId     = L"StartupProfile";
-const std::wstring kConfigKeyAfterburnerDirPath   = L"AfterburnerDirPath";
-const std::wstring kConfigKeyProfileName          = L"Name";
-const std::wstring kConfigKeyProfileEnabled       = L"Enabled";
-const std::wstring kConfigKeyLanguage             = L"Lang";
-const std::wstring kConfigKeyEnableRunAfterburner = L"EnableRunAfterburnerMenuItem";
-
-const std::wstring kEmptyString;
-const size_t kProfilesCount = 5;
-const std::wstring kDefaultProfileNamePrefix = L"Profile ";
-const uint32_t kMaxStartupProfileDelay = 120; // Seconds.
-const int kInvalidStarupProfileId = -1;
-const std::wstring kAfterburnerArgProfilePrefix = L"-Profile";
-const std::wstring kAfterburnerArgProfileQuit = L" -q";
-const std::wstring kAfterburnerExeName = L"MSIAfterburner.exe";
-const std::wstring kProgramFiles = L"Program Files";
-const std::wstring kProgramFiles86 = L"Program Files (x86)";
-const std::wstring kSelectFolderCaption = L"'MSI Afterburner' folder";
-
-const std::vector<std::wstring> kDefaultAfterburnerDirPaths
-{
-    kProgramFiles86 + L"\\MSI Afterburner",
-    kProgramFiles + L"\\MSI Afterburner"
-};
-
-
-AfterburnerController::AfterburnerController()
-    : config(getConfigFilePath())
-    , startupProfileId(kInvalidStarupProfileId)
-{}
-
-
-AfterburnerController::~AfterburnerController()
-{}
-
-
-bool AfterburnerController::init()
-{
-    applyConfig();
-
-    return !enabledProfiles.empty() && tryFindAfterburnerExecutable();
-}
-
-
-std::wstring AfterburnerController::getConfigFilePath()
-{
-    return FileSystem::getDirWithFile(FileSystem::getExecutableDirPath(), kConfigName);
-}
-
-
-const std::wstring& AfterburnerController::getPreferredLanguage()
-{
-    return config.getValue(kConfigSectionMain, kConfigKeyLanguage);
-}
-
-
-bool AfterburnerController::isRunAfterburnerMenuEnabled() const
-{
-    return config.getValue(kConfigSectionMain, kConfigKeyEnableRunAfterburner, 1) != 0;
-}
-
-
-void AfterburnerController::applyConfig()
-{
-    if (!FileSystem::isFileExist(config.getPath()))
-    {
-        config.setValue(kConfigSectionMain, kConfigKeyStartupProfileDelay, 5);
-        config.setValue(kConfigSectionMain, kConfigKeyStartupProfileId, kEmptyString);
-        config.setValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath, kEmptyString);
-        config.setValue(kConfigSectionMain, kConfigKeyLanguage, kEmptyString);
-        config.setValue(kConfigSectionMain, kConfigKeyEnableRunAfterburner, 1);
-
-        for (size_t i = 0; i < kProfilesCount; ++i)
-        {
-            const std::wstring profileSectionName = std::to_wstring(i + 1);
-            config.setValue(profileSectionName, kConfigKeyProfileName, kDefaultProfileNamePrefix + profileSectionName);
-            config.setValue(profileSectionName, kConfigKeyProfileEnabled, 1);
-        }
-
-        config.save();
-    }
-
-    const int tempStartupProfileId = config.getValue(kConfigSectionMain, kConfigKeyStartupProfileId, kInvalidStarupProfileId);
-
-    for (const auto &section : config.listSections())
-    {
-        if (section != kConfigSectionMain)
-        {
-            if (config.getValue(section, kConfigKeyProfileEnabled, false))
-            {
-                try
-                {
-                    const int profileId = std::stoi(section);
-                    if (profileId > 0 && profileId <= kProfilesCount)
-                    {
-                        const std::wstring name =
-                            config.getValue(section, kConfigKeyProfileName, kDefaultProfileNamePrefix + std::to_wstring(profileId));
-
-                        enabledProfiles.emplace(name, profileId);
-
-                        if (tempStartupProfileId == profileId)
-                        {
-                            startupProfileId = tempStartupProfileId;
-                            startupProfileName = name;
-                        }
-                    }
-                }
-                catch (...) {}
-            }
-        }
-    }
-}
-
-
-bool AfterburnerController::tryFindAfterburnerExecutable()
-{
-    std::wstring afterburnerDirPath = config.getValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath);
-    if (!afterburnerDirPath.empty())
-    {
-        afterburnerExecutablePath = getValidAfterburnerPath(afterburnerDirPath);
-    }
-
-    if (afterburnerExecutablePath.empty())
-    {
-        afterburnerExecutablePath = getValidAfterburnerPath(FileSystem::getExecutableDirPath());
-    }
-
-    for (size_t i = 0; i < kDefaultAfterburnerDirPaths.size() && afterburnerExecutablePath.empty(); ++i)
-    {
-        for (wchar_t disk = 'A'; disk <= 'Z' && afterburnerExecutablePath.empty(); ++disk)
-        {
-            afterburnerExecutablePath = getValidAfterburnerPath(std::wstring(1, disk) + L":\\" + kDefaultAfterburnerDirPaths[i]);
-        }
-    }
-
-    if (afterburnerExecutablePath.empty())
-    {
-        afterburnerExecutablePath = getValidAfterburnerPath(FileSystem::browseForFolder(kSelectFolderCaption, L"C:\\" + kProgramFiles86));
-    }
-
-    if (!afterburnerExecutablePath.empty())
-    {
-        config.setValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath, FileSystem::getDirWithoutFile(afterburnerExecutablePath));
-        config.save();
-    }
-
-    return !afterburnerExecutablePath.empty();
-}
-
-
-std::wstring AfterburnerController::getValidAfterburnerPath(const std::wstring &dirPath)
-{
-    const std::wstring fullPath = FileSystem::getDirWithFile(dirPath, kAfterburnerExeName);
-
-    return FileSystem::isFileExist(fullPath) && WindowsCommon::safeValidateExeSignature(fullPath)
-        ? fullPath
-        : kEmptyString;
-}
-
-
-uint32_t AfterburnerController::getStartupProfileDelay() const
-{
-    return (std::min<uint32_t>)(kMaxStartupProfileDelay, config.getValue(kConfigSectionMain, kConfigKeyStartupProfileDelay, 0));
-}
-
-
-void AfterburnerController::setStartupProfile(const std::wstring &name)
-{
-    auto it = enabledProfiles.find(name);
-    if (it != enabledProfiles.end())
-    {
-        startupProfileId = it->second;
-        startupProfileName = name;
-
-        config.setValue(kConfigSectionMain, kConfigKeyStartupProfileId, startupProfileId);
-        config.save();
-    }
-}
-
-
-void AfterburnerController::removeStartupProfile()
-{
-    startupProfileId = kInvalidStarupProfileId;
-    startupProfileName.clear();
-
-    config.clearValue(kConfigSectionMain, kConfigKeyStartupProfileId);
-    config.save();
-}
-
-
-const std::wstring& AfterburnerController::getStartupProfile() const
-{
-    return startupProfileName;
-}
-
-
-std::vector<std::wstring> AfterburnerController::getAvailableProfiles()
-{
-    std::vector<std::wstring> profiles;
-
-    for (const auto &prof : enabledProfiles)
-    {
-        profiles.push_back(prof.first);
-    }
-
-    return profiles;
-}
-
-
-bool AfterburnerController::applyProfile(const std::wstring &name)
-{
-    const auto it = enabledProfiles.find(name);
-
-    return it != enabledProfiles.end() && WindowsCommon::safeExec(afterburnerExecutablePath,
-        kAfterburnerArgProfilePrefix + std::to_wstring(it->second) + kAfterburnerArgProfileQuit);
-}
-
-
-bool AfterburnerController::runAfterburner()
-{
-    return WindowsCommon::safeExec(afterburnerExecutablePath, kEmptyString);
-}
-
-
-}
-
-
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AfterburnerController.h"
+#include "AfterburnerLocatorBackend.h"
+#include "ConfigSnapshot.h"
+#include "../utils/FileSystem.h"
+#include "../utils/TextUtils.h"
+#include "../utils/WindowsCommon.h"
+
+
+namespace Loader
+{
+
+const std::wstring kConfigName = L"MSIAfterburnerLoader.cfg";
+const std::wstring kMachineConfigDirName = L"MSIAfterburnerLoader";
+const std::wstring kSignatureCacheSuffix = L".signatures";
+const std::wstring kStatisticsSuffix = L".stats.json";
+const wchar_t kHashesDelimiters[] = L",;";
+const std::wstring kEmptyString;
+const std::wstring kAfterburnerArgProfilePrefix = L"-Profile";
+const std::wstring kAfterburnerArgProfileQuit = L" -q";
+const std::wstring kAfterburnerExeName = L"MSIAfterburner.exe";
+const std::wstring kProgramFiles86 = L"Program Files (x86)";
+const std::wstring kSelectFolderCaption = L"'MSI Afterburner' folder";
+const uint32_t kAfterburnerProbeTimeout = 2000;     // Milliseconds, for every group of probed folders.
+const uint32_t kAfterburnerLateProbeTimeout = 8000; // Milliseconds, for all abandoned probes before the folder dialog.
+
+
+AfterburnerController::AfterburnerController()
+    : configWriteBack((uint32_t)settings.configSaveDelay, [this]() { return saveConfig(); })
+    , signatureCache(std::make_shared<SignatureCache>(getSignatureCacheFilePath()))
+    , lastExecTimings()
+    , processLauncher(createProcessLauncher())
+    , configFileInfo()
+    , startupProfileId(kInvalidProfileId)
+    , appliedProfileId(kInvalidProfileId)
+    , appliedGeneration(0)
+    , stateGeneration(0)
+    , isConfigLoaded(false)
+{
+    // Only [Main] and profile sections are read, other sections of the files are never parsed.
+    config.setLoadMode(ConfigLoadMode::Lazy);
+    machineConfig.setLoadMode(ConfigLoadMode::Lazy);
+
+    AfterburnerSettings::writeFallbacks(&defaultsConfig);
+    layeredConfig.setLayers(&config, {&machineConfig, &defaultsConfig});
+}
+
+
+AfterburnerController::~AfterburnerController()
+{
+    flushConfig();
+}
+
+
+bool AfterburnerController::init()
+{
+    const bool isSnapshotLoaded = loadSnapshot();
+    if (!isSnapshotLoaded)
+    {
+        applyConfig();
+    }
+
+    const bool isInitialized = !enabledProfiles.empty() && (isSnapshotLoaded || tryFindAfterburnerExecutable());
+
+    configWriteBack.setQuietPeriod((uint32_t)settings.configSaveDelay);
+
+    // With pending changes snapshot is saved after the config file is written.
+    if (isInitialized && !isSnapshotLoaded && !configWriteBack.isDirty())
+    {
+        saveSnapshot();
+    }
+
+    publishConfigState();
+
+    return isInitialized;
+}
+
+
+std::wstring AfterburnerController::getConfigFilePath()
+{
+    return FileSystem::getDirWithFile(FileSystem::getExecutableDirPath(), kConfigName);
+}
+
+
+std::wstring AfterburnerController::getMachineConfigFilePath()
+{
+    const std::wstring programDataPath = FileSystem::getProgramDataDirPath();
+
+    return !programDataPath.empty()
+        ? FileSystem::getDirWithFile(FileSystem::getDirWithFile(programDataPath, kMachineConfigDirName), kConfigName)
+        : kEmptyString;
+}
+
+
+std::wstring AfterburnerController::getSignatureCacheFilePath()
+{
+    return getConfigFilePath() + kSignatureCacheSuffix;
+}
+
+
+std::wstring AfterburnerController::getStatisticsFilePath()
+{
+    return getConfigFilePath() + kStatisticsSuffix;
+}
+
+
+void AfterburnerController::ensureConfigLoaded()
+{
+    if (!isConfigLoaded)
+    {
+        // File that can not be read now keeps the previous values and state, it is loaded again on the next call.
+        isConfigLoaded = config.reload(getConfigFilePath());
+        machineConfig.reload(getMachineConfigFilePath());
+        configFileInfo = config.getFileInfo();
+    }
+}
+
+
+void AfterburnerController::applyConfig()
+{
+    ensureConfigLoaded();
+
+    if (!FileSystem::isFileExist(config.getPath()))
+    {
+        AfterburnerSettings::writeDefaults(&config);
+
+        // Default config is written immediately, so user can edit it right after the first start.
+        configWriteBack.markDirty();
+        configWriteBack.flush();
+    }
+
+    readConfig();
+}
+
+
+void AfterburnerController::readConfig()
+{
+    enabledProfiles.clear();
+    startupProfileId = kInvalidProfileId;
+    startupProfileName.clear();
+
+    settings.load(layeredConfig);
+    applyPinnedHashes();
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        const ProfileSettings &profile = settings.profiles[i];
+        const int profileId = (int)i + 1;
+
+        if (profile.isEnabled)
+        {
+            enabledProfiles.emplace(profile.name, profileId);
+
+            if (settings.startupProfileId == profileId)
+            {
+                startupProfileId = profileId;
+                startupProfileName = profile.name;
+            }
+        }
+    }
+}
+
+
+void AfterburnerController::applyPinnedHashes()
+{
+    std::vector<Sha256::Digest> hashes;
+    size_t start = 0;
+
+    while (start < settings.afterburnerSha256.size())
+    {
+        size_t end = settings.afterburnerSha256.find_first_of(kHashesDelimiters, start);
+        end = end != std::wstring::npos ? end : settings.afterburnerSha256.size();
+
+        const std::wstring_view hex = TextUtils::trim(std::wstring_view(settings.afterburnerSha256).substr(start, end - start));
+
+        if (!hex.empty())
+        {
+            // Malformed hash never matches: a typo must not turn pinning off.
+            Sha256::Digest hash = {0};
+            if (!Sha256::fromHex(hex, &hash))
+            {
+                hash.fill(0);
+            }
+
+            hashes.push_back(hash);
+        }
+
+        start = end + 1;
+    }
+
+    signatureCache->setPinnedHashes(hashes);
+}
+
+
+bool AfterburnerController::saveConfig()
+{
+    const uint64_t prevMergedSaves = config.getMergedSaves();
+    const bool isSaved = config.save();
+
+    // After merging with changes made by someone else the stored file state is left as is,
+    // so the reload that follows the change notification applies them to settings and the snapshot.
+    if (isSaved && isConfigLoaded && config.getMergedSaves() == prevMergedSaves)
+    {
+        configFileInfo = config.getFileInfo();
+        saveSnapshot();
+    }
+
+    return isSaved;
+}
+
+
+void AfterburnerController::writeStartupProfileId()
+{
+    if (startupProfileId != kInvalidProfileId)
+    {
+        layeredConfig.setValue(kConfigSectionMain, kConfigKeyStartupProfileId, startupProfileId);
+    }
+    else
+    {
+        layeredConfig.clearValue(kConfigSectionMain, kConfigKeyStartupProfileId);
+
+        // Empty value does not hide startup profile of the machine wide config, invalid id does.
+        if (layeredConfig.getValue(kConfigSectionMain, kConfigKeyStartupProfileId, kInvalidProfileId) != kInvalidProfileId)
+        {
+            layeredConfig.setValue(kConfigSectionMain, kConfigKeyStartupProfileId, kInvalidProfileId);
+        }
+    }
+}
+
+
+bool AfterburnerController::loadSnapshot()
+{
+    ConfigSnapshot snapshot;
+
+    const bool isLoaded = snapshot.load(getConfigFilePath(), getMachineConfigFilePath()) && !snapshot.enabledProfiles.empty() &&
+        FileSystem::isFileExist(snapshot.afterburnerExecutablePath);
+
+    if (isLoaded)
+    {
+        enabledProfiles = std::move(snapshot.enabledProfiles);
+        afterburnerExecutablePath = std::move(snapshot.afterburnerExecutablePath);
+        settings.afterburnerSha256 = std::move(snapshot.afterburnerSha256);
+        settings.preferredLanguage = std::move(snapshot.preferredLanguage);
+        settings.startupProfileDelay = (int32_t)snapshot.startupProfileDelay;
+        settings.configSaveDelay = (int32_t)snapshot.configSaveDelay;
+        settings.applyTimeout = (int32_t)snapshot.applyTimeout;
+        settings.isRunAfterburnerMenuEnabled = snapshot.isRunAfterburnerMenuEnabled;
+        FileSystem::getFileInfo(getConfigFilePath(), &configFileInfo);
+        startupProfileId = kInvalidProfileId;
+        startupProfileName.clear();
+
+        for (const auto &profile : enabledProfiles)
+        {
+            if (profile.second == snapshot.startupProfileId)
+            {
+                startupProfileId = profile.second;
+                startupProfileName = profile.first;
+            }
+        }
+
+        settings.startupProfileId = startupProfileId;
+        settings.afterburnerDirPath = FileSystem::getDirWithoutFile(afterburnerExecutablePath);
+        applyPinnedHashes();
+    }
+
+    return isLoaded;
+}
+
+
+void AfterburnerController::saveSnapshot()
+{
+    ConfigSnapshot snapshot;
+    snapshot.enabledProfiles = enabledProfiles;
+    snapshot.afterburnerExecutablePath = afterburnerExecutablePath;
+    snapshot.afterburnerSha256 = settings.afterburnerSha256;
+    snapshot.preferredLanguage = settings.preferredLanguage;
+    snapshot.startupProfileId = startupProfileId;
+    snapshot.startupProfileDelay = (uint32_t)settings.startupProfileDelay;
+    snapshot.configSaveDelay = (uint32_t)settings.configSaveDelay;
+    snapshot.applyTimeout = (uint32_t)settings.applyTimeout;
+    snapshot.isRunAfterburnerMenuEnabled = settings.isRunAfterburnerMenuEnabled;
+
+    // States of the parsed files: a change made since then is loaded by the reload that follows its notification.
+    snapshot.save(getConfigFilePath(), ConfigSnapshot::FileState{config.getFileInfo(), config.getContentHash()},
+        ConfigSnapshot::FileState{machineConfig.getFileInfo(), machineConfig.getContentHash()});
+}
+
+
+bool AfterburnerController::tryFindAfterburnerExecutable()
+{
+    AfterburnerLocator locator(std::make_shared<AfterburnerLocatorBackend>(signatureCache), kAfterburnerProbeTimeout);
+
+    afterburnerExecutablePath = locator.find({settings.afterburnerDirPath, FileSystem::getExecutableDirPath()});
+
+    // Asking the user takes longer than a slow drive, its probe is waited for once more.
+    if (afterburnerExecutablePath.empty())
+    {
+        afterburnerExecutablePath = locator.collectLateResult(kAfterburnerLateProbeTimeout);
+    }
+
+    if (afterburnerExecutablePath.empty())
+    {
+        afterburnerExecutablePath = getValidAfterburnerPath(FileSystem::browseForFolder(kSelectFolderCaption, L"C:\\" + kProgramFiles86));
+    }
+
+    if (!afterburnerExecutablePath.empty())
+    {
+        settings.afterburnerDirPath = FileSystem::getDirWithoutFile(afterburnerExecutablePath);
+
+        // Path provided by the machine wide config is not copied to the user config.
+        if (layeredConfig.getValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath) != settings.afterburnerDirPath)
+        {
+            layeredConfig.setValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath, settings.afterburnerDirPath);
+            configWriteBack.markDirty();
+        }
+    }
+
+    return !afterburnerExecutablePath.empty();
+}
+
+
+std::wstring AfterburnerController::getValidAfterburnerPath(const std::wstring &dirPath)
+{
+    const std::wstring fullPath = FileSystem::getDirWithFile(dirPath, kAfterburnerExeName);
+
+    return FileSystem::isFileExist(fullPath) && WindowsCommon::safeValidateExeSignature(fullPath, signatureCache.get())
+        ? fullPath
+        : kEmptyString;
+}
+
+
+bool AfterburnerController::hasPendingConfigChanges() const
+{
+    return configWriteBack.isDirty();
+}
+
+
+bool AfterburnerController::flushConfig()
+{
+    return configWriteBack.flush();
+}
+
+
+const WriteBackScheduler& AfterburnerController::getConfigWriteBack() const
+{
+    return configWriteBack;
+}
+
+
+const SignatureCache& AfterburnerController::getSignatureCache() const
+{
+    return *signatureCache;
+}
+
+
+const WindowsCommon::ExecTimings& AfterburnerController::getLastExecTimings() const
+{
+    return lastExecTimings;
+}
+
+
+void AfterburnerController::setStartupProfile(const std::wstring &name)
+{
+    auto it = enabledProfiles.find(name);
+    if (it != enabledProfiles.end())
+    {
+        startupProfileId = it->second;
+        startupProfileName = name;
+
+        settings.startupProfileId = startupProfileId;
+
+        ensureConfigLoaded();
+        writeStartupProfileId();
+        configWriteBack.markDirty();
+        publishConfigState();
+    }
+}
+
+
+void AfterburnerController::removeStartupProfile()
+{
+    startupProfileId = kInvalidProfileId;
+    startupProfileName.clear();
+    settings.startupProfileId = kInvalidProfileId;
+
+    ensureConfigLoaded();
+    writeStartupProfileId();
+    configWriteBack.markDirty();
+    publishConfigState();
+}
+
+
+std::vector<std::wstring> AfterburnerController::getAvailableProfiles()
+{
+    std::vector<std::wstring> profiles;
+
+    for (const auto &prof : enabledProfiles)
+    {
+        profiles.push_back(prof.first);
+    }
+
+    return profiles;
+}
+
+
+bool AfterburnerController::reloadConfig()
+{
+    bool isChanged = false;
+
+    FileSystem::FileInfo fileInfo = {};
+    const bool isFileChanged = FileSystem::getFileInfo(getConfigFilePath(), &fileInfo) &&
+        (fileInfo.size != configFileInfo.size || fileInfo.lastWriteTime != configFileInfo.lastWriteTime);
+
+    // Own saves are skipped: file state is remembered after every save.
+    if (isFileChanged)
+    {
+        const std::map<std::wstring, int> prevProfiles = enabledProfiles;
+        const int prevStartupProfileId = startupProfileId;
+        const bool hasPendingChanges = configWriteBack.isDirty();
+
+        isConfigLoaded = false;
+        ensureConfigLoaded();
+
+        // File locked by its writer keeps the old state, so the change notification that follows the write retries.
+        if (isConfigLoaded)
+        {
+            // Changes made from the menu and not saved yet are newer than the file.
+            if (hasPendingChanges)
+            {
+                writeStartupProfileId();
+
+                if (!afterburnerExecutablePath.empty())
+                {
+                    layeredConfig.setValue(kConfigSectionMain, kConfigKeyAfterburnerDirPath, FileSystem::getDirWithoutFile(afterburnerExecutablePath));
+                }
+            }
+
+            readConfig();
+            configWriteBack.setQuietPeriod((uint32_t)settings.configSaveDelay);
+
+            if (!hasPendingChanges)
+            {
+                saveSnapshot();
+            }
+
+            publishConfigState();
+
+            isChanged = prevProfiles != enabledProfiles || prevStartupProfileId != startupProfileId;
+        }
+    }
+
+    return isChanged;
+}
+
+
+SnapshotPublisher<AfterburnerConfigState>::Snapshot AfterburnerController::getConfigState() const
+{
+    return configState.acquire();
+}
+
+
+void AfterburnerController::publishConfigState()
+{
+    configState.publish(AfterburnerConfigState{settings, enabledProfiles, startupProfileName, afterburnerExecutablePath});
+}
+
+
+void AfterburnerController::setProcessLauncher(std::unique_ptr<IProcessLauncher> launcher)
+{
+    processLauncher = std::move(launcher);
+}
+
+
+bool AfterburnerController::applyProfile(const std::wstring &name, HANDLE *outProcess)
+{
+    const auto it = enabledProfiles.find(name);
+
+    return it != enabledProfiles.end() && WindowsCommon::safeExec(afterburnerExecutablePath,
+        kAfterburnerArgProfilePrefix + std::to_wstring(it->second) + kAfterburnerArgProfileQuit, signatureCache.get(), &lastExecTimings,
+        processLauncher.get(), outProcess);
+}
+
+
+bool AfterburnerController::runAfterburner()
+{
+    invalidateAppliedProfile();
+
+    return WindowsCommon::safeExec(afterburnerExecutablePath, kEmptyString, signatureCache.get(), &lastExecTimings,
+        processLauncher.get());
+}
+
+
+uint64_t AfterburnerController::getAppliedStateGeneration() const
+{
+    return stateGeneration;
+}
+
+
+void AfterburnerController::confirmAppliedProfile(const std::wstring &name, uint64_t generation)
+{
+    const auto it = enabledProfiles.find(name);
+
+    if (it != enabledProfiles.end() && generation == stateGeneration)
+    {
+        appliedProfileId = it->second;
+        appliedGeneration = generation;
+    }
+}
+
+
+void AfterburnerController::invalidateAppliedProfile()
+{
+    stateGeneration++;
+}
+
+
+bool AfterburnerController::isProfileApplied(const std::wstring &name)
+{
+    // Profiles can be changed in the GUI while it runs.
+    if (appliedProfileId != kInvalidProfileId && WindowsCommon::isProcessRunning(kAfterburnerExeName))
+    {
+        invalidateAppliedProfile();
+    }
+
+    const auto it = enabledProfiles.find(name);
+
+    return it != enabledProfiles.end() && it->second == appliedProfileId && appliedGeneration == stateGeneration;
+}
+
+
+}
+
+
+
+
@@ -1,71 +1,134 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#ifndef __AFETRBURNER_CONTROLLER_H__
-#define __AFETRBURNER_CONTROLLER_H__
-
-
-#include "../utils/ConfigFile.h"
-#include <string>
-
-
-namespace Loader
-{
-
-
-class AfterburnerController
-{
-public:
-    AfterburnerController();
-    ~AfterburnerController();
-
-    static std::wstring getConfigFilePath();
-
-    bool init();
-    const std::wstring& getPreferredLanguage();
-    bool isRunAfterburnerMenuEnabled() const;
-    uint32_t getStartupProfileDelay() const;
-    void setStartupProfile(const std::wstring &name);
-    void removeStartupProfile();
-    const std::wstring& getStartupProfile() const;
-    std::vector<std::wstring> getAvailableProfiles();
-    bool applyProfile(const std::wstring &name);
-    bool runAfterburner();
-
-private:
-    void applyConfig();
-    bool tryFindAfterburnerExecutable();
-    std::wstring getValidAfterburnerPath(const std::wstring &dirPath);
-
-private:
-    ConfigFile<std::wstring> config;
-    std::map<std::wstring, int> enabledProfiles; // <profile name, profile id>
-    int startupProfileId;
-    std::wstring startupProfileName;
-    std::wstring afterburnerExecutablePath;
-
-};
-
-}
-
-
-#endif
-
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AFETRBURNER_CONTROLLER_H__
+#define __AFETRBURNER_CONTROLLER_H__
+
+
+#include "AfterburnerSettings.h"
+#include "../utils/ConfigFile.h"
+#include "../utils/LayeredConfig.h"
+#include "../utils/ProcessLauncher.h"
+#include "../utils/SignatureCache.h"
+#include "../utils/SnapshotPublisher.h"
+#include "../utils/WindowsCommon.h"
+#include "../utils/WriteBackScheduler.h"
+#include <map>
+#include <memory>
+#include <string>
+
+
+namespace Loader
+{
+
+
+// Immutable copy of the controller configuration for readers on other threads.
+struct AfterburnerConfigState
+{
+    AfterburnerSettings settings;
+    std::map<std::wstring, int> enabledProfiles; // <profile name, profile id>
+    std::wstring startupProfile;
+    std::wstring afterburnerExecutablePath;
+};
+
+
+class AfterburnerController
+{
+public:
+    AfterburnerController();
+    ~AfterburnerController();
+
+    static std::wstring getConfigFilePath();
+    static std::wstring getMachineConfigFilePath();
+    static std::wstring getSignatureCacheFilePath();
+    static std::wstring getStatisticsFilePath();
+
+    bool init();
+    bool hasPendingConfigChanges() const;
+    bool flushConfig();
+    const WriteBackScheduler& getConfigWriteBack() const;
+    const SignatureCache& getSignatureCache() const;
+    const WindowsCommon::ExecTimings& getLastExecTimings() const; // Stages of the last started 'MSI Afterburner'.
+    void setStartupProfile(const std::wstring &name);
+    void removeStartupProfile();
+    std::vector<std::wstring> getAvailableProfiles();
+    // Re-reads the config file if it was changed by someone else.
+    // Returns true if profiles or startup profile have changed.
+    bool reloadConfig();
+    // Settings, profiles and startup profile for all readers. Safe to call from any thread, never blocks.
+    // Snapshot is replaced after every change of the configuration.
+    SnapshotPublisher<AfterburnerConfigState>::Snapshot getConfigState() const;
+    void setProcessLauncher(std::unique_ptr<IProcessLauncher> launcher);
+    // Optional 'outProcess' receives handle of the started 'MSI Afterburner' to wait for it, the caller closes it.
+    bool applyProfile(const std::wstring &name, HANDLE *outProcess = nullptr);
+    bool runAfterburner();
+
+    // Profile applied by the last successful 'MSI Afterburner' run stays active until something else could change
+    // the GPU state: resume from sleep, 'MSI Afterburner' started by the user or running on its own.
+    // Confirmation uses the generation taken before the apply started, so an invalidation made meanwhile wins.
+    uint64_t getAppliedStateGeneration() const;
+    void confirmAppliedProfile(const std::wstring &name, uint64_t stateGeneration);
+    void invalidateAppliedProfile();
+    bool isProfileApplied(const std::wstring &name);
+
+private:
+    void ensureConfigLoaded();
+    void applyConfig();
+    void readConfig();
+    void applyPinnedHashes();
+    bool saveConfig();
+    void writeStartupProfileId();
+    void publishConfigState();
+    bool loadSnapshot();
+    void saveSnapshot();
+    bool tryFindAfterburnerExecutable();
+    std::wstring getValidAfterburnerPath(const std::wstring &dirPath);
+
+private:
+    // Config layers from the top one: user file near the executable, optional read only machine wide
+    // file and built-in defaults. Files are loaded on demand: not needed while the snapshot is valid.
+    ConfigFile<std::wstring> config;
+    ConfigFile<std::wstring> machineConfig;
+    ConfigFile<std::wstring> defaultsConfig;
+    LayeredConfig<std::wstring> layeredConfig;
+    AfterburnerSettings settings;
+    WriteBackScheduler configWriteBack;
+    SnapshotPublisher<AfterburnerConfigState> configState;
+    std::shared_ptr<SignatureCache> signatureCache; // Shared with discovery probes.
+    WindowsCommon::ExecTimings lastExecTimings;
+    std::unique_ptr<IProcessLauncher> processLauncher;
+    FileSystem::FileInfo configFileInfo; // Config file state at last load or save.
+    std::map<std::wstring, int> enabledProfiles; // <profile name, profile id>
+    int startupProfileId;
+    int appliedProfileId;
+    uint64_t appliedGeneration;
+    uint64_t stateGeneration;
+    std::wstring startupProfileName;
+    std::wstring afterburnerExecutablePath;
+    bool isConfigLoaded;
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AfterburnerLocator.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Loader
+{
+
+// Shared with worker threads, outlives the locator if some probes are abandoned.
+struct ProbeGroupState
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::wstring result;
+    size_t pendingProbes;
+};
+
+
+AfterburnerLocator::AfterburnerLocator(const std::shared_ptr<IAfterburnerLocatorBackend> &backend, uint32_t probeTimeoutMs)
+    : backend(backend)
+    , probeTimeoutMs(probeTimeoutMs)
+    , startedProbes(0)
+    , timedOutProbes(0)
+    , lateResults(0)
+{}
+
+
+std::wstring AfterburnerLocator::find(const std::vector<std::wstring> &preferredDirs)
+{
+    std::wstring executablePath;
+
+    for (size_t i = 0; i < preferredDirs.size() && executablePath.empty(); ++i)
+    {
+        executablePath = probe({preferredDirs[i]});
+    }
+
+    if (executablePath.empty())
+    {
+        executablePath = probe(backend->getRegisteredDirs());
+    }
+
+    if (executablePath.empty())
+    {
+        executablePath = probe(backend->getDefaultDirs());
+    }
+
+    return executablePath;
+}
+
+
+std::wstring AfterburnerLocator::collectLateResult(uint32_t timeoutMs)
+{
+    std::wstring executablePath;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (size_t i = 0; i < abandonedGroups.size() && executablePath.empty(); ++i)
+    {
+        const auto &state = abandonedGroups[i];
+        std::unique_lock<std::mutex> lock(state->mutex);
+
+        state->finished.wait_until(lock, deadline, [&state]() { return !state->result.empty() || state->pendingProbes == 0; });
+
+        executablePath = state->result;
+    }
+
+    if (!executablePath.empty())
+    {
+        lateResults++;
+        abandonedGroups.clear();
+    }
+
+    return executablePath;
+}
+
+
+uint32_t AfterburnerLocator::getStartedProbes() const
+{
+    return startedProbes;
+}
+
+
+uint32_t AfterburnerLocator::getTimedOutProbes() const
+{
+    return timedOutProbes;
+}
+
+
+uint32_t AfterburnerLocator::getLateResults() const
+{
+    return lateResults;
+}
+
+
+std::wstring AfterburnerLocator::probe(const std::vector<std::wstring> &dirs)
+{
+    std::vector<std::wstring> newDirs;
+
+    for (const auto &dir : dirs)
+    {
+        if (!dir.empty() && std::find(probedDirs.begin(), probedDirs.end(), dir) == probedDirs.end())
+        {
+            probedDirs.push_back(dir);
+            newDirs.push_back(dir);
+        }
+    }
+
+    std::wstring executablePath;
+
+    if (!newDirs.empty())
+    {
+        const auto state = std::make_shared<ProbeGroupState>();
+        state->pendingProbes = newDirs.size();
+
+        for (const auto &dir : newDirs)
+        {
+            // Worker keeps the backend and the state alive, so it can safely finish after the timeout.
+            std::thread([state, backend = backend, dir]()
+            {
+                const std::wstring path = backend->probeDir(dir);
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+
+                if (state->result.empty())
+                {
+                    state->result = path;
+                }
+
+                state->pendingProbes--;
+                state->finished.notify_one();
+            }).detach();
+        }
+
+        startedProbes += (uint32_t)newDirs.size();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+
+        state->finished.wait_for(lock, std::chrono::milliseconds(probeTimeoutMs),
+            [&state]() { return !state->result.empty() || state->pendingProbes == 0; });
+
+        executablePath = state->result;
+
+        if (executablePath.empty() && state->pendingProbes > 0)
+        {
+            timedOutProbes += (uint32_t)state->pendingProbes;
+            abandonedGroups.push_back(state);
+        }
+    }
+
+    return executablePath;
+}
+
+
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LOADER_AFTERBURNER_LOCATOR_H__
+#define __LOADER_AFTERBURNER_LOCATOR_H__
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace Loader
+{
+
+struct ProbeGroupState;
+
+
+// System queries used to locate 'MSI Afterburner', replaceable to run the locator without real drives.
+class IAfterburnerLocatorBackend
+{
+public:
+    virtual ~IAfterburnerLocatorBackend() {}
+
+    // Cheap queries, called on the locator thread.
+    virtual std::vector<std::wstring> getRegisteredDirs() = 0;
+    virtual std::vector<std::wstring> getDefaultDirs() = 0;
+
+    // Returns path of a valid executable in the folder or empty string. Can block for a long time
+    // on slow or disconnected drives, called concurrently from worker threads.
+    virtual std::wstring probeDir(const std::wstring &dirPath) = 0;
+
+};
+
+
+// Finds 'MSI Afterburner' executable: cheap sources are asked first, one group after another,
+// folders of a group are probed concurrently and the first valid hit wins. Every group waits for
+// at most the probe timeout, probes that do not finish in time are abandoned, not waited for.
+class AfterburnerLocator
+{
+public:
+    AfterburnerLocator(const std::shared_ptr<IAfterburnerLocatorBackend> &backend, uint32_t probeTimeoutMs);
+
+    // Groups in order: each of 'preferredDirs' (configured or previously found folder), folders from
+    // the registry and default install folders on all drives.
+    std::wstring find(const std::vector<std::wstring> &preferredDirs);
+
+    // Abandoned probes may still succeed, e.g. a configured folder on a drive that spins up too long.
+    // Gives them up to 'timeoutMs' more in total, groups in the order of 'find', so the configured folder
+    // is waited for first and results that came late from other groups are taken without waiting.
+    // Meant to be called before the user is asked for the folder.
+    std::wstring collectLateResult(uint32_t timeoutMs);
+
+    uint32_t getStartedProbes() const;
+    uint32_t getTimedOutProbes() const;
+    uint32_t getLateResults() const;
+
+private:
+    std::wstring probe(const std::vector<std::wstring> &dirs);
+
+private:
+    std::shared_ptr<IAfterburnerLocatorBackend> backend;
+    uint32_t probeTimeoutMs;
+    std::vector<std::wstring> probedDirs;
+    std::vector<std::shared_ptr<ProbeGroupState>> abandonedGroups;
+    uint32_t startedProbes;
+    uint32_t timedOutProbes;
+    uint32_t lateResults;
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AfterburnerLocatorBackend.h"
+#include "../utils/FileSystem.h"
+#include "../utils/WindowsCommon.h"
+
+
+namespace Loader
+{
+
+const std::wstring kLocatorExeName = L"MSIAfterburner.exe";
+const wchar_t kUninstallKeyPath[] = L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\Afterburner";
+const wchar_t kInstallLocationValue[] = L"InstallLocation";
+const wchar_t kUninstallStringValue[] = L"UninstallString";
+
+const std::vector<std::wstring> kDefaultInstallDirs
+{
+    L"Program Files (x86)\\MSI Afterburner",
+    L"Program Files\\MSI Afterburner"
+};
+
+// 32-bit installer registers itself in the redirected view on 64-bit systems, check both views.
+const REGSAM kRegistryViews[] = {KEY_WOW64_32KEY, KEY_WOW64_64KEY};
+
+
+static std::wstring readRegistryString(HKEY key, const wchar_t *valueName)
+{
+    std::wstring value;
+    DWORD size = 0;
+
+    if (RegGetValueW(key, nullptr, valueName, RRF_RT_REG_SZ | RRF_RT_REG_EXPAND_SZ, nullptr, nullptr, &size) == ERROR_SUCCESS &&
+        size > sizeof(wchar_t))
+    {
+        value.resize(size / sizeof(wchar_t));
+
+        if (RegGetValueW(key, nullptr, valueName, RRF_RT_REG_SZ | RRF_RT_REG_EXPAND_SZ, nullptr, &value[0], &size) == ERROR_SUCCESS)
+        {
+            value.resize(wcsnlen(value.c_str(), value.size()));
+        }
+        else
+        {
+            value.clear();
+        }
+    }
+
+    return value;
+}
+
+
+static std::wstring getDirFromCommandLine(std::wstring commandLine)
+{
+    if (!commandLine.empty() && commandLine[0] == L'"')
+    {
+        const size_t quoteEnd = commandLine.find(L'"', 1);
+        commandLine = commandLine.substr(1, quoteEnd != std::wstring::npos ? quoteEnd - 1 : std::wstring::npos);
+    }
+
+    return FileSystem::getDirWithoutFile(commandLine);
+}
+
+
+AfterburnerLocatorBackend::AfterburnerLocatorBackend(const std::shared_ptr<SignatureCache> &signatureCache)
+    : signatureCache(signatureCache)
+{}
+
+
+std::vector<std::wstring> AfterburnerLocatorBackend::getRegisteredDirs()
+{
+    std::vector<std::wstring> dirs;
+
+    for (const REGSAM view : kRegistryViews)
+    {
+        HKEY key = nullptr;
+
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, kUninstallKeyPath, 0, KEY_QUERY_VALUE | view, &key) == ERROR_SUCCESS)
+        {
+            const std::wstring installLocation = readRegistryString(key, kInstallLocationValue);
+            if (!installLocation.empty())
+            {
+                dirs.push_back(installLocation);
+            }
+
+            const std::wstring uninstallString = readRegistryString(key, kUninstallStringValue);
+            if (!uninstallString.empty())
+            {
+                dirs.push_back(getDirFromCommandLine(uninstallString));
+            }
+
+            RegCloseKey(key);
+        }
+    }
+
+    return dirs;
+}
+
+
+std::vector<std::wstring> AfterburnerLocatorBackend::getDefaultDirs()
+{
+    std::vector<std::wstring> dirs;
+
+    // Only present drives are probed, missing ones are known from the drives mask without touching them.
+    const DWORD drivesMask = GetLogicalDrives();
+
+    for (const auto &installDir : kDefaultInstallDirs)
+    {
+        for (wchar_t disk = 'A'; disk <= 'Z'; ++disk)
+        {
+            if ((drivesMask & (1u << (disk - 'A'))) != 0)
+            {
+                dirs.push_back(std::wstring(1, disk) + L":\\" + installDir);
+            }
+        }
+    }
+
+    return dirs;
+}
+
+
+std::wstring AfterburnerLocatorBackend::probeDir(const std::wstring &dirPath)
+{
+    const std::wstring fullPath = FileSystem::getDirWithFile(dirPath, kLocatorExeName);
+
+    return FileSystem::isFileExist(fullPath) && WindowsCommon::safeValidateExeSignature(fullPath, signatureCache.get())
+        ? fullPath
+        : std::wstring();
+}
+
+
+}
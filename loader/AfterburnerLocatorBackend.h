@@ -0,0 +1,53 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LOADER_AFTERBURNER_LOCATOR_BACKEND_H__
+#define __LOADER_AFTERBURNER_LOCATOR_BACKEND_H__
+
+
+#include "AfterburnerLocator.h"
+#include "../utils/SignatureCache.h"
+
+
+namespace Loader
+{
+
+// Real system: uninstall records in the registry, install folders on present drives,
+// executable is valid if it exists and has a valid signature.
+class AfterburnerLocatorBackend : public IAfterburnerLocatorBackend
+{
+public:
+    explicit AfterburnerLocatorBackend(const std::shared_ptr<SignatureCache> &signatureCache);
+
+    std::vector<std::wstring> getRegisteredDirs() override;
+    std::vector<std::wstring> getDefaultDirs() override;
+    std::wstring probeDir(const std::wstring &dirPath) override;
+
+private:
+    std::shared_ptr<SignatureCache> signatureCache; // Shared with probes that may outlive the owner.
+
+};
+
+}
+
+
+#endif
+
+
+
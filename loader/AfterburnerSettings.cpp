@@ -0,0 +1,237 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AfterburnerSettings.h"
+#include <algorithm>
+
+
+namespace Loader
+{
+
+enum class SettingType
+{
+    Int,
+    Bool,
+    String
+};
+
+
+enum class RangePolicy
+{
+    Clamp, // Out of range value is replaced by the nearest bound.
+    Reset  // Out of range value is replaced by the default value.
+};
+
+
+template<typename Settings>
+struct SettingField
+{
+    std::wstring_view key;
+    SettingType type;
+    std::wstring_view defaultText; // Written to the default config file.
+    int32_t defaultValue;          // Used when value is missing or invalid.
+    int32_t minValue;
+    int32_t maxValue;
+    RangePolicy rangePolicy;
+    bool hasProfileIdSuffix;       // Profile id is appended to the default text.
+    int32_t Settings::*intField;
+    bool Settings::*boolField;
+    std::wstring Settings::*stringField;
+};
+
+
+template<typename Settings>
+constexpr SettingField<Settings> intSetting(std::wstring_view key, int32_t Settings::*field, std::wstring_view defaultText,
+    int32_t defaultValue, int32_t minValue, int32_t maxValue, RangePolicy rangePolicy)
+{
+    return SettingField<Settings>{key, SettingType::Int, defaultText, defaultValue, minValue, maxValue, rangePolicy, false,
+        field, nullptr, nullptr};
+}
+
+
+template<typename Settings>
+constexpr SettingField<Settings> boolSetting(std::wstring_view key, bool Settings::*field, std::wstring_view defaultText, bool defaultValue)
+{
+    return SettingField<Settings>{key, SettingType::Bool, defaultText, defaultValue ? 1 : 0, 0, 1, RangePolicy::Reset, false,
+        nullptr, field, nullptr};
+}
+
+
+template<typename Settings>
+constexpr SettingField<Settings> stringSetting(std::wstring_view key, std::wstring Settings::*field, std::wstring_view defaultText,
+    bool hasProfileIdSuffix = false)
+{
+    return SettingField<Settings>{key, SettingType::String, defaultText, 0, 0, 0, RangePolicy::Reset, hasProfileIdSuffix,
+        nullptr, nullptr, field};
+}
+
+
+constexpr SettingField<AfterburnerSettings> kMainSchema[] =
+{
+    intSetting(kConfigKeyStartupProfileDelay, &AfterburnerSettings::startupProfileDelay, L"5", 0, 0, 120, RangePolicy::Clamp),
+    intSetting(kConfigKeyStartupProfileId, &AfterburnerSettings::startupProfileId, L"", kInvalidProfileId, 1, (int32_t)kProfilesCount, RangePolicy::Reset),
+    stringSetting(kConfigKeyAfterburnerDirPath, &AfterburnerSettings::afterburnerDirPath, L""),
+    stringSetting(kConfigKeyAfterburnerSha256, &AfterburnerSettings::afterburnerSha256, L""),
+    stringSetting(kConfigKeyLanguage, &AfterburnerSettings::preferredLanguage, L""),
+    boolSetting(kConfigKeyEnableRunAfterburner, &AfterburnerSettings::isRunAfterburnerMenuEnabled, L"1", true),
+    intSetting(kConfigKeyConfigSaveDelay, &AfterburnerSettings::configSaveDelay, L"2000", 2000, 0, 60000, RangePolicy::Clamp),
+    intSetting(kConfigKeyApplyTimeout, &AfterburnerSettings::applyTimeout, L"30000", 30000, 1000, 600000, RangePolicy::Clamp)
+};
+
+
+constexpr SettingField<ProfileSettings> kProfileSchema[] =
+{
+    stringSetting(kConfigKeyProfileName, &ProfileSettings::name, L"Profile ", true),
+    boolSetting(kConfigKeyProfileEnabled, &ProfileSettings::isEnabled, L"1", false)
+};
+
+
+template<typename Settings>
+static std::wstring getDefaultText(const SettingField<Settings> &field, int32_t profileId)
+{
+    std::wstring text(field.defaultText);
+
+    if (field.hasProfileIdSuffix)
+    {
+        text.append(std::to_wstring(profileId));
+    }
+
+    return text;
+}
+
+
+// Reads values of schema fields from the config section, defaults are used if 'config' is null.
+template<typename Settings, size_t FieldsCount>
+static void readFields(const LayeredConfig<std::wstring> *config, std::wstring_view section, int32_t profileId,
+    const SettingField<Settings> (&schema)[FieldsCount], Settings *outSettings)
+{
+    for (const auto &field : schema)
+    {
+        if (field.type == SettingType::Int)
+        {
+            int32_t value = config != nullptr
+                ? config->getValue(section, field.key, field.defaultValue)
+                : field.defaultValue;
+
+            if (value < field.minValue || value > field.maxValue)
+            {
+                value = field.rangePolicy == RangePolicy::Clamp
+                    ? (std::min)((std::max)(value, field.minValue), field.maxValue)
+                    : field.defaultValue;
+            }
+
+            outSettings->*field.intField = value;
+        }
+        else if (field.type == SettingType::Bool)
+        {
+            outSettings->*field.boolField = config != nullptr
+                ? config->getValue(section, field.key, field.defaultValue) != 0
+                : field.defaultValue != 0;
+        }
+        else
+        {
+            outSettings->*field.stringField = config != nullptr
+                ? config->getValue(section, field.key, getDefaultText(field, profileId))
+                : getDefaultText(field, profileId);
+        }
+    }
+}
+
+
+template<typename Settings, size_t FieldsCount>
+static void writeFields(ConfigFile<std::wstring> *config, std::wstring_view section, int32_t profileId,
+    const SettingField<Settings> (&schema)[FieldsCount])
+{
+    for (const auto &field : schema)
+    {
+        config->setValue(section, field.key, std::wstring_view(getDefaultText(field, profileId)));
+    }
+}
+
+
+template<typename Settings, size_t FieldsCount>
+static void writeFallbackFields(ConfigFile<std::wstring> *config, std::wstring_view section, int32_t profileId,
+    const SettingField<Settings> (&schema)[FieldsCount])
+{
+    for (const auto &field : schema)
+    {
+        if (field.type == SettingType::String)
+        {
+            config->setValue(section, field.key, std::wstring_view(getDefaultText(field, profileId)));
+        }
+        else
+        {
+            config->setValue(section, field.key, field.defaultValue);
+        }
+    }
+}
+
+
+AfterburnerSettings::AfterburnerSettings()
+{
+    readFields(nullptr, kConfigSectionMain, 0, kMainSchema, this);
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        const int32_t profileId = (int32_t)i + 1;
+        readFields(nullptr, std::to_wstring(profileId), profileId, kProfileSchema, &profiles[i]);
+    }
+}
+
+
+void AfterburnerSettings::load(const LayeredConfig<std::wstring> &config)
+{
+    readFields(&config, kConfigSectionMain, 0, kMainSchema, this);
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        const int32_t profileId = (int32_t)i + 1;
+        readFields(&config, std::to_wstring(profileId), profileId, kProfileSchema, &profiles[i]);
+    }
+}
+
+
+void AfterburnerSettings::writeDefaults(ConfigFile<std::wstring> *config)
+{
+    writeFields(config, kConfigSectionMain, 0, kMainSchema);
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        const int32_t profileId = (int32_t)i + 1;
+        writeFields(config, std::to_wstring(profileId), profileId, kProfileSchema);
+    }
+}
+
+
+void AfterburnerSettings::writeFallbacks(ConfigFile<std::wstring> *config)
+{
+    writeFallbackFields(config, kConfigSectionMain, 0, kMainSchema);
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        const int32_t profileId = (int32_t)i + 1;
+        writeFallbackFields(config, std::to_wstring(profileId), profileId, kProfileSchema);
+    }
+}
+
+
+}
+
+
+
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LOADER_AFTERBURNER_SETTINGS_H__
+#define __LOADER_AFTERBURNER_SETTINGS_H__
+
+
+#include "../utils/ConfigFile.h"
+#include "../utils/LayeredConfig.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+namespace Loader
+{
+
+constexpr std::wstring_view kConfigSectionMain             = L"Main";
+constexpr std::wstring_view kConfigKeyStartupProfileDelay  = L"StartupDelay";
+constexpr std::wstring_view kConfigKeyStartupProfileId     = L"StartupProfile";
+constexpr std::wstring_view kConfigKeyAfterburnerDirPath   = L"AfterburnerDirPath";
+constexpr std::wstring_view kConfigKeyAfterburnerSha256    = L"AfterburnerSha256";
+constexpr std::wstring_view kConfigKeyProfileName          = L"Name";
+constexpr std::wstring_view kConfigKeyProfileEnabled       = L"Enabled";
+constexpr std::wstring_view kConfigKeyLanguage             = L"Lang";
+constexpr std::wstring_view kConfigKeyEnableRunAfterburner = L"EnableRunAfterburnerMenuItem";
+constexpr std::wstring_view kConfigKeyConfigSaveDelay      = L"ConfigSaveDelay";
+constexpr std::wstring_view kConfigKeyApplyTimeout         = L"ApplyTimeout";
+
+constexpr size_t kProfilesCount = 5; // Profile sections are named by profile id: '1' ... '5'.
+constexpr int32_t kInvalidProfileId = -1;
+
+
+struct ProfileSettings
+{
+    std::wstring name;
+    bool isEnabled;
+};
+
+
+// Typed settings of the config file.
+// Sections, keys, types, defaults and allowed ranges are described by a compile time schema,
+// values are parsed and validated once by 'load', out of range values are clamped or reset to defaults.
+struct AfterburnerSettings
+{
+    int32_t startupProfileDelay; // Seconds.
+    int32_t startupProfileId;
+    std::wstring afterburnerDirPath;
+    std::wstring afterburnerSha256; // Allowed hashes of the executable separated by ',' or ';', empty allows any signed build.
+    std::wstring preferredLanguage;
+    bool isRunAfterburnerMenuEnabled;
+    int32_t configSaveDelay; // Milliseconds.
+    int32_t applyTimeout; // Milliseconds, hung 'MSI Afterburner' started to apply a profile is terminated after it.
+    ProfileSettings profiles[kProfilesCount];
+
+    AfterburnerSettings();
+
+    void load(const LayeredConfig<std::wstring> &config);
+    // Values of a new config file.
+    static void writeDefaults(ConfigFile<std::wstring> *config);
+    // Values used when no config file has the key: the bottom layer of the layered config.
+    static void writeFallbacks(ConfigFile<std::wstring> *config);
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ApplyQueue.h"
+
+
+namespace Loader
+{
+
+ApplyQueue::ApplyQueue()
+    : pending{std::wstring(), 0, ApplyPriority::Automatic, false}
+    , runningPriority(ApplyPriority::Automatic)
+    , isRunning(false)
+    , isPending(false)
+    , startedRequests(0)
+    , skippedRequests(0)
+    , supersededRequests(0)
+    , droppedRequests(0)
+{}
+
+
+bool ApplyQueue::push(const ApplyRequest &request)
+{
+    bool isStartNeeded = false;
+
+    if (!isRunning)
+    {
+        runningPriority = request.priority;
+        isRunning = true;
+        isStartNeeded = true;
+        startedRequests++;
+    }
+    else if (request.priority == ApplyPriority::Automatic &&
+        (runningPriority == ApplyPriority::User || (isPending && pending.priority == ApplyPriority::User)))
+    {
+        droppedRequests++;
+    }
+    else
+    {
+        if (isPending)
+        {
+            supersededRequests++;
+        }
+
+        pending = request;
+        isPending = true;
+    }
+
+    return isStartNeeded;
+}
+
+
+bool ApplyQueue::finish(ApplyRequest *outNext)
+{
+    isRunning = isPending;
+
+    if (isPending)
+    {
+        *outNext = std::move(pending);
+        runningPriority = outNext->priority;
+        isPending = false;
+        startedRequests++;
+    }
+
+    return isRunning;
+}
+
+
+bool ApplyQueue::skipIfApplied(const ApplyRequest &request, const AppliedCheck &isApplied)
+{
+    const bool isSkipped = !request.isForced && isApplied(request.profile);
+
+    if (isSkipped)
+    {
+        skippedRequests++;
+    }
+
+    return isSkipped;
+}
+
+
+uint64_t ApplyQueue::getStartedRequests() const
+{
+    return startedRequests;
+}
+
+
+uint64_t ApplyQueue::getSkippedRequests() const
+{
+    return skippedRequests;
+}
+
+
+uint64_t ApplyQueue::getSupersededRequests() const
+{
+    return supersededRequests;
+}
+
+
+uint64_t ApplyQueue::getDroppedRequests() const
+{
+    return droppedRequests;
+}
+
+
+uint64_t ApplyQueue::getSavedSpawns() const
+{
+    return skippedRequests + supersededRequests + droppedRequests;
+}
+
+
+}
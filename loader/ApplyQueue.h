@@ -0,0 +1,93 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LOADER_APPLY_QUEUE_H__
+#define __LOADER_APPLY_QUEUE_H__
+
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+
+namespace Loader
+{
+
+enum class ApplyPriority
+{
+    Automatic, // Startup profile.
+    User       // Profile chosen in the menu.
+};
+
+
+struct ApplyRequest
+{
+    std::wstring profile;
+    uint16_t menuId; // Zero for automatic requests.
+    ApplyPriority priority;
+    bool isForced; // Started even if the profile is already applied.
+};
+
+
+// Keeps at most one profile apply in flight, so instances of 'MSI Afterburner' never race on the GPU.
+// Requests made meanwhile wait in a single pending slot, a newer request replaces the pending one.
+// Automatic requests never replace or follow user requests: the user choice wins.
+class ApplyQueue
+{
+public:
+    // Returns true if the profile is confirmed as applied, so starting 'MSI Afterburner' would change nothing.
+    typedef std::function<bool(const std::wstring &profile)> AppliedCheck;
+
+    ApplyQueue();
+
+    // Returns true if the request must be started right now, otherwise it is pending or dropped.
+    bool push(const ApplyRequest &request);
+    // Marks the running apply as finished. Returns true if 'outNext' receives the pending request,
+    // which is running from now on and must be started.
+    bool finish(ApplyRequest *outNext);
+    // Called for the running request before it is started. Returns true if it is not forced and 'isApplied'
+    // confirms its profile: the owner finishes it as applied without starting anything. Forced requests
+    // are not checked at all.
+    bool skipIfApplied(const ApplyRequest &request, const AppliedCheck &isApplied);
+
+    uint64_t getStartedRequests() const;
+    uint64_t getSkippedRequests() const;    // Running requests answered by the already applied profile.
+    uint64_t getSupersededRequests() const; // Pending requests replaced by newer ones before they started.
+    uint64_t getDroppedRequests() const;    // Automatic requests ignored because of user ones.
+    uint64_t getSavedSpawns() const;        // Requests that did not start 'MSI Afterburner' for any of the reasons above.
+
+private:
+    ApplyRequest pending;
+    ApplyPriority runningPriority;
+    bool isRunning;
+    bool isPending;
+    uint64_t startedRequests;
+    uint64_t skippedRequests;
+    uint64_t supersededRequests;
+    uint64_t droppedRequests;
+
+};
+
+}
+
+
+#endif
+
+
+
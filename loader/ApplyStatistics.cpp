@@ -0,0 +1,155 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "ApplyStatistics.h"
+#include "../utils/FileSystem.h"
+
+
+namespace Loader
+{
+
+
+const char *const kStageNames[] = {"fileLock", "signatureCheck", "processSpawn", "processExit", "uiUpdate"};
+const double kReportedPercentiles[] = {50.0, 90.0, 99.0};
+
+static_assert(sizeof(kStageNames) / sizeof(kStageNames[0]) == (size_t)ApplyStage::Count, "Name of every stage is required");
+
+
+ApplyStatistics::ApplyStatistics()
+{}
+
+
+void ApplyStatistics::record(ApplyStage stage, uint32_t microseconds)
+{
+    if (stage < ApplyStage::Count)
+    {
+        histograms[(size_t)stage].record(microseconds);
+    }
+}
+
+
+const LatencyHistogram& ApplyStatistics::getHistogram(ApplyStage stage) const
+{
+    return histograms[stage < ApplyStage::Count ? (size_t)stage : 0];
+}
+
+
+void ApplyStatistics::reset()
+{
+    for (auto &histogram : histograms)
+    {
+        histogram.reset();
+    }
+}
+
+
+std::wstring ApplyStatistics::format(const Labels &labels) const
+{
+    std::wstring text;
+
+    for (size_t i = 0; i < (size_t)ApplyStage::Count; ++i)
+    {
+        const LatencyHistogram &histogram = histograms[i];
+
+        text += labels.stageNames[i] + L": " + std::to_wstring(histogram.getCount());
+
+        if (histogram.getCount() != 0)
+        {
+            text += L", " + labels.min + L" " + std::to_wstring(histogram.getMin()) +
+                L", " + labels.mean + L" " + std::to_wstring(histogram.getMean());
+
+            for (const double percentile : kReportedPercentiles)
+            {
+                text += L", p" + std::to_wstring((int)percentile) + L" " + std::to_wstring(histogram.getPercentile(percentile));
+            }
+
+            text += L", " + labels.max + L" " + std::to_wstring(histogram.getMax()) + L" " + labels.unit;
+        }
+
+        text += L"\n";
+    }
+
+    return text;
+}
+
+
+std::string ApplyStatistics::toJson() const
+{
+    std::string json = "{\n  \"unit\": \"us\",\n  \"stages\": {";
+
+    for (size_t i = 0; i < (size_t)ApplyStage::Count; ++i)
+    {
+        const LatencyHistogram &histogram = histograms[i];
+
+        json += std::string(i != 0 ? "," : "") + "\n    \"" + kStageNames[i] + "\": {" +
+            "\"count\": " + std::to_string(histogram.getCount()) +
+            ", \"sum\": " + std::to_string(histogram.getSum()) +
+            ", \"min\": " + std::to_string(histogram.getMin()) +
+            ", \"mean\": " + std::to_string(histogram.getMean()) +
+            ", \"max\": " + std::to_string(histogram.getMax());
+
+        for (const double percentile : kReportedPercentiles)
+        {
+            json += ", \"p" + std::to_string((int)percentile) + "\": " + std::to_string(histogram.getPercentile(percentile));
+        }
+
+        // Every bucket is [lowest value, highest value, count].
+        json += ", \"buckets\": [";
+        bool isFirstBucket = true;
+
+        for (size_t bucket = 0; bucket < LatencyHistogram::kBucketsCount; ++bucket)
+        {
+            const uint64_t bucketCount = histogram.getBucketCount(bucket);
+
+            if (bucketCount != 0)
+            {
+                json += std::string(isFirstBucket ? "" : ", ") +
+                    "[" + std::to_string(LatencyHistogram::getBucketLowest(bucket)) +
+                    ", " + std::to_string(LatencyHistogram::getBucketHighest(bucket)) +
+                    ", " + std::to_string(bucketCount) + "]";
+
+                isFirstBucket = false;
+            }
+        }
+
+        json += "]}";
+    }
+
+    json += "\n  }\n}\n";
+
+    return json;
+}
+
+
+bool ApplyStatistics::dump(const std::wstring &path) const
+{
+    const std::string json = toJson();
+
+    return FileSystem::writeFileAtomically(path, json.data(), json.size(), FileSystem::WriteDurability::None);
+}
+
+
+const char* ApplyStatistics::getStageName(ApplyStage stage)
+{
+    return stage < ApplyStage::Count ? kStageNames[(size_t)stage] : "";
+}
+
+}
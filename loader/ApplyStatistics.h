@@ -0,0 +1,83 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __LOADER_APPLY_STATISTICS_H__
+#define __LOADER_APPLY_STATISTICS_H__
+
+
+#include <cstdint>
+#include <string>
+#include "../utils/LatencyHistogram.h"
+
+
+namespace Loader
+{
+
+enum class ApplyStage
+{
+    FileLock,       // Opening and locking 'MSI Afterburner' executable.
+    SignatureCheck, // Content hash and signature verification or cache lookup.
+    ProcessSpawn,
+    ProcessExit,    // From the start of 'MSI Afterburner' until its exit is handled.
+    UiUpdate,       // Tooltip and menu update after the apply.
+    Count
+};
+
+
+// Durations of profile apply stages in microseconds, one histogram per stage.
+class ApplyStatistics
+{
+public:
+    // Translated texts of the human readable summary.
+    struct Labels
+    {
+        std::wstring stageNames[(size_t)ApplyStage::Count];
+        std::wstring min;
+        std::wstring mean;
+        std::wstring max;
+        std::wstring unit;
+    };
+
+    ApplyStatistics();
+
+    void record(ApplyStage stage, uint32_t microseconds);
+    const LatencyHistogram& getHistogram(ApplyStage stage) const;
+    void reset();
+
+    // Human readable summary: count, min, mean, percentiles and max of every stage.
+    std::wstring format(const Labels &labels) const;
+    // Same summary with non empty buckets as JSON, names are not translated.
+    std::string toJson() const;
+    bool dump(const std::wstring &path) const;
+
+    static const char* getStageName(ApplyStage stage);
+
+private:
+    LatencyHistogram histograms[(size_t)ApplyStage::Count];
+
+};
+
+}
+
+
+#endif
+
+
@@ -0,0 +1,271 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ConfigSnapshot.h"
+#include "../utils/FileSystem.h"
+#include <cstring>
+
+
+namespace Loader
+{
+
+const std::wstring kSnapshotSuffix = L".cache";
+const uint32_t kSnapshotMagic = 0x5342414D; // 'MABS'
+const uint32_t kSnapshotVersion = 4;
+const uint32_t kMaxSnapshotStringLength = 32 * 1024;
+const uint32_t kMaxSnapshotProfilesCount = 1024;
+
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t configSize;
+    uint64_t configWriteTime;
+    uint64_t configHash;
+    uint64_t machineConfigSize;
+    uint64_t machineConfigWriteTime;
+    uint64_t machineConfigHash;
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+
+
+// Hash of the current content of the config file, 'outInfo' receives its size and modification time.
+static bool getConfigHash(const std::wstring &configPath, FileSystem::FileInfo *outInfo, uint64_t *outHash)
+{
+    bool isReceived = false;
+
+    if (FileSystem::getFileInfo(configPath, outInfo))
+    {
+        const FileSystem::MappedFile config(configPath);
+
+        if (config.isMapped() && config.getSize() == outInfo->size)
+        {
+            *outHash = FileSystem::getContentHash(config.getData(), config.getSize());
+            isReceived = true;
+        }
+    }
+
+    return isReceived;
+}
+
+
+// Machine config is optional: missing file is described by zero size, time and hash.
+static bool getMachineConfigHash(const std::wstring &machineConfigPath, FileSystem::FileInfo *outInfo, uint64_t *outHash)
+{
+    bool isReceived = true;
+
+    *outInfo = FileSystem::FileInfo{0, 0};
+    *outHash = 0;
+
+    if (!machineConfigPath.empty() && FileSystem::isFileExist(machineConfigPath))
+    {
+        isReceived = getConfigHash(machineConfigPath, outInfo, outHash);
+    }
+
+    return isReceived;
+}
+
+
+template<typename T>
+static void write(std::string *out, const T &value)
+{
+    out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+static void write(std::string *out, const std::wstring &value)
+{
+    write(out, (uint32_t)value.size());
+    out->append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(wchar_t));
+}
+
+
+template<typename T>
+static bool read(const char **inOutData, const char *dataEnd, T *outValue)
+{
+    const bool isRead = (size_t)(dataEnd - *inOutData) >= sizeof(T);
+
+    if (isRead)
+    {
+        memcpy(outValue, *inOutData, sizeof(T));
+        *inOutData += sizeof(T);
+    }
+
+    return isRead;
+}
+
+
+static bool read(const char **inOutData, const char *dataEnd, std::wstring *outValue)
+{
+    uint32_t length = 0;
+    const bool isRead = read(inOutData, dataEnd, &length) && length <= kMaxSnapshotStringLength &&
+        (size_t)(dataEnd - *inOutData) >= length * sizeof(wchar_t);
+
+    if (isRead)
+    {
+        outValue->resize(length);
+        memcpy(&(*outValue)[0], *inOutData, length * sizeof(wchar_t));
+        *inOutData += length * sizeof(wchar_t);
+    }
+
+    return isRead;
+}
+
+
+ConfigSnapshot::ConfigSnapshot()
+    : startupProfileId(-1)
+    , startupProfileDelay(0)
+    , configSaveDelay(0)
+    , applyTimeout(0)
+    , isRunAfterburnerMenuEnabled(true)
+{}
+
+
+std::wstring ConfigSnapshot::getSnapshotPath(const std::wstring &configPath)
+{
+    return configPath + kSnapshotSuffix;
+}
+
+
+bool ConfigSnapshot::load(const std::wstring &configPath, const std::wstring &machineConfigPath)
+{
+    const FileSystem::MappedFile snapshot(getSnapshotPath(configPath));
+    SnapshotHeader header = {};
+
+    bool isLoaded = snapshot.isMapped() && snapshot.getSize() >= sizeof(header);
+
+    if (isLoaded)
+    {
+        memcpy(&header, snapshot.getData(), sizeof(header));
+
+        const char *data = snapshot.getData() + sizeof(header);
+        const char *dataEnd = snapshot.getData() + snapshot.getSize();
+
+        FileSystem::FileInfo configInfo = {};
+        FileSystem::FileInfo machineConfigInfo = {};
+        uint64_t configHash = 0;
+        uint64_t machineConfigHash = 0;
+
+        isLoaded =
+            header.magic == kSnapshotMagic &&
+            header.version == kSnapshotVersion &&
+            header.payloadSize == (uint64_t)(dataEnd - data) &&
+            header.payloadHash == FileSystem::getContentHash(data, (size_t)header.payloadSize) &&
+            getConfigHash(configPath, &configInfo, &configHash) &&
+            header.configSize == configInfo.size &&
+            header.configWriteTime == configInfo.lastWriteTime &&
+            header.configHash == configHash &&
+            getMachineConfigHash(machineConfigPath, &machineConfigInfo, &machineConfigHash) &&
+            header.machineConfigSize == machineConfigInfo.size &&
+            header.machineConfigWriteTime == machineConfigInfo.lastWriteTime &&
+            header.machineConfigHash == machineConfigHash;
+
+        uint32_t isRunMenuEnabled = 0;
+        uint32_t profilesCount = 0;
+
+        isLoaded = isLoaded &&
+            read(&data, dataEnd, &startupProfileId) &&
+            read(&data, dataEnd, &startupProfileDelay) &&
+            read(&data, dataEnd, &configSaveDelay) &&
+            read(&data, dataEnd, &applyTimeout) &&
+            read(&data, dataEnd, &isRunMenuEnabled) &&
+            read(&data, dataEnd, &afterburnerExecutablePath) &&
+            read(&data, dataEnd, &afterburnerSha256) &&
+            read(&data, dataEnd, &preferredLanguage) &&
+            read(&data, dataEnd, &profilesCount) &&
+            profilesCount <= kMaxSnapshotProfilesCount;
+
+        isRunAfterburnerMenuEnabled = isRunMenuEnabled != 0;
+        enabledProfiles.clear();
+
+        for (uint32_t i = 0; i < profilesCount && isLoaded; ++i)
+        {
+            int32_t profileId = 0;
+            std::wstring profileName;
+
+            isLoaded = read(&data, dataEnd, &profileId) && read(&data, dataEnd, &profileName);
+            if (isLoaded)
+            {
+                enabledProfiles.emplace(std::move(profileName), profileId);
+            }
+        }
+
+        isLoaded = isLoaded && data == dataEnd;
+    }
+
+    return isLoaded;
+}
+
+
+bool ConfigSnapshot::save(const std::wstring &configPath, const FileState &configState, const FileState &machineConfigState) const
+{
+    // Snapshot of a missing or empty config file would never be valid.
+    bool isSaved = configState.hash != 0;
+
+    if (isSaved)
+    {
+        std::string payload;
+        write(&payload, startupProfileId);
+        write(&payload, startupProfileDelay);
+        write(&payload, configSaveDelay);
+        write(&payload, applyTimeout);
+        write(&payload, (uint32_t)(isRunAfterburnerMenuEnabled ? 1 : 0));
+        write(&payload, afterburnerExecutablePath);
+        write(&payload, afterburnerSha256);
+        write(&payload, preferredLanguage);
+        write(&payload, (uint32_t)enabledProfiles.size());
+
+        for (const auto &profile : enabledProfiles)
+        {
+            write(&payload, (int32_t)profile.second);
+            write(&payload, profile.first);
+        }
+
+        SnapshotHeader header = {};
+        header.magic = kSnapshotMagic;
+        header.version = kSnapshotVersion;
+        header.configSize = configState.info.size;
+        header.configWriteTime = configState.info.lastWriteTime;
+        header.configHash = configState.hash;
+        header.machineConfigSize = machineConfigState.info.size;
+        header.machineConfigWriteTime = machineConfigState.info.lastWriteTime;
+        header.machineConfigHash = machineConfigState.hash;
+        header.payloadSize = payload.size();
+        header.payloadHash = FileSystem::getContentHash(payload.data(), payload.size());
+
+        std::string snapshot;
+        snapshot.reserve(sizeof(header) + payload.size());
+        write(&snapshot, header);
+        snapshot.append(payload);
+
+        // Snapshot is only a cache, losing it on power failure just means one slower start.
+        isSaved = FileSystem::writeFileAtomically(getSnapshotPath(configPath), snapshot.data(), snapshot.size(),
+            FileSystem::WriteDurability::None);
+    }
+
+    return isSaved;
+}
+
+
+}
+
+
+
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LOADER_CONFIG_SNAPSHOT_H__
+#define __LOADER_CONFIG_SNAPSHOT_H__
+
+
+#include "../utils/FileSystem.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+
+namespace Loader
+{
+
+// State derived from the config file, stored in a binary file near it to skip
+// parsing on startup. Snapshot is used only while size, modification time and
+// content hash of the config file and of the optional machine wide config file
+// are the same as at the moment it was saved.
+struct ConfigSnapshot
+{
+    // Config file the settings were parsed from, zero for a missing file.
+    struct FileState
+    {
+        FileSystem::FileInfo info;
+        uint64_t hash; // 'FileSystem::getContentHash' of the whole file.
+    };
+
+    std::map<std::wstring, int> enabledProfiles; // <profile name, profile id>
+    std::wstring afterburnerExecutablePath;
+    std::wstring afterburnerSha256;
+    std::wstring preferredLanguage;
+    int32_t startupProfileId;
+    uint32_t startupProfileDelay;
+    uint32_t configSaveDelay;
+    uint32_t applyTimeout;
+    bool isRunAfterburnerMenuEnabled;
+
+    ConfigSnapshot();
+
+    bool load(const std::wstring &configPath, const std::wstring &machineConfigPath);
+    // File states must be taken when the settings were parsed: the files can be changed since then,
+    // and the snapshot must not describe the new content with the old settings.
+    bool save(const std::wstring &configPath, const FileState &configState, const FileState &machineConfigState) const;
+
+    static std::wstring getSnapshotPath(const std::wstring &configPath);
+};
+
+}
+
+
+#endif
+
+
+
@@ -1,399 +1,751 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "LoaderApp.h"
-#include "../resources/resource.h"
-#include "../utils/ConfigFile.h"
-#include "../utils/FileSystem.h"
-#include "../utils/Translator.h"
-#include "../utils/WindowsCommon.h"
-#include <Commctrl.h>
-#include <regex>
-
-
-namespace Loader
-{
-
-
-const wchar_t *kMainWindowClass = L"AfterburnerProfileLoaderMainClass";
-const wchar_t *kMainWindowName = L"AfterburnerProfileLoaderMainWindow";
-const std::wstring kAutorunName = L"AfterburnerProfileLoader";
-const UINT_PTR kStartupTimerId = 1025;
-const uint16_t kInitialProfileMenuItemId = 20000;
-const uint16_t kOnStartProfileMenuItemShift = 1000;
-
-const std::map<uint16_t, LoaderApp::MenuHandler> LoaderApp::kOnMenuHandlers
-{
-    {IDS_QUIT,            &LoaderApp::onQuit},
-    {IDS_ABOUT,           &LoaderApp::onAbout},
-    {IDS_AUTORUN,         &LoaderApp::onAutorun},
-    {IDS_RUN_AFTERBURNER, &LoaderApp::onRunAfterburner}
-};
-
-
-LoaderApp::LoaderApp()
-    : trayIcon(this)
-    , isUserChangedProfile(false)
-    , mainMenu(nullptr)
-    , onStartMenu(nullptr)
-    , aboutDialog(nullptr)
-{}
-
-
-bool LoaderApp::start()
-{
-    stop();
-
-    return create(kMainWindowClass, kMainWindowName, this);
-}
-
-
-void LoaderApp::stop()
-{
-    destroy();
-}
-
-
-HWND LoaderApp::getHwnd()
-{
-    return getWindowHandle();
-}
-
-
-void LoaderApp::onDestroy()
-{
-    trayIcon.removeFromTray();
-
-    if (aboutDialog)
-    {
-        DestroyWindow(aboutDialog);
-        aboutDialog = nullptr;
-    }
-}
-
-
-void LoaderApp::onIconContextMenu(const POINT &position)
-{
-    showContextMenu(position, mainMenu);
-}
-
-
-const std::wstring& LoaderApp::translate(TranslationID id)
-{
-    return translator.translate(id);
-}
-
-
-void LoaderApp::createMenu()
-{
-    HMENU root = CreateMenu();
-    mainMenu = CreatePopupMenu();
-    onStartMenu = CreatePopupMenu();
-
-    appendMenu(mainMenu, onStartMenu, IDS_ONSTART);
-    appendMenuCheckBox(mainMenu, IDS_AUTORUN, taskScheduler.isTaskExist(kAutorunName));
-    appendMenuSeparator(mainMenu);
-
-    const auto &availableProfiles = afterburner.getAvailableProfiles();
-    const auto &startupProfile = afterburner.getStartupProfile();
-    uint16_t profileMenuId = kInitialProfileMenuItemId;
-
-    for (const auto &profile : afterburner.getAvailableProfiles())
-    {
-        profileMenuId++;
-
-        profilesMenuMap.emplace(profileMenuId, profile);
-        const bool isProfileOnStartup = profile == startupProfile;
-
-        appendMenuCheckBox(mainMenu, profileMenuId, profile, isProfileOnStartup);
-        appendMenuCheckBox(onStartMenu, profileMenuId + kOnStartProfileMenuItemShift, profile, isProfileOnStartup);
-    }
-
-    if (afterburner.isRunAfterburnerMenuEnabled())
-    {
-        appendMenuSeparator(mainMenu);
-        appendMenu(mainMenu, IDS_RUN_AFTERBURNER);
-    }
-
-    appendMenuSeparator(mainMenu);
-    appendMenu(mainMenu, IDS_ABOUT);
-    appendMenu(mainMenu, IDS_QUIT);
-    appendMenu(root, mainMenu, 0);
-
-    SetMenu(getHwnd(), root);
-}
-
-
-static INT_PTR CALLBACK aboutDialogProc(HWND hwndDlg, UINT message, WPARAM wParam, LPARAM lParam)
-{
-    INT_PTR retVal = FALSE;
-
-    if (message == WM_INITDIALOG)
-    {
-        ILoaderApp *app = reinterpret_cast<ILoaderApp *>(lParam);
-        if (app)
-        {
-            const HICON icon = (HICON)LoadImageW(MY_HINSTANCE, MAKEINTRESOURCEW(IDI_SMALL), IMAGE_ICON,
-                GetSystemMetrics(SM_CXSMICON), GetSystemMetrics(SM_CYSMICON), 0);
-
-            if (icon)
-            {
-                SendMessage(hwndDlg, WM_SETICON, ICON_SMALL, (LPARAM)icon);
-            }
-            SetWindowText(hwndDlg, app->translate(IDS_ABOUT).c_str());
-            SetDlgItemTextW(hwndDlg, IDC_APP_NAME, app->translate(IDS_APP_NAME).c_str());
-            SetDlgItemTextW(hwndDlg, IDC_APP_VERSION, WindowsCommon::getAppVersion(FileSystem::getExecutablePath()).c_str());
-            SetDlgItemTextW(hwndDlg, IDC_EDIT_CONFIG,
-                std::regex_replace(app->translate(IDS_EDIT_CONFIG),
-                    std::wregex(L"<a>"), L"<a href=\"" + AfterburnerController::getConfigFilePath() + L"\">").c_str());
-            SetDlgItemTextW(hwndDlg, IDC_SOURCE_CODE, app->translate(IDS_SOURCE_CODE).c_str());
-            SetDlgItemTextW(hwndDlg, IDC_RELEASES, app->translate(IDS_RELEASES).c_str());
-            SetDlgItemTextW(hwndDlg, IDC_LICENSE, app->translate(IDS_LICENSE).c_str());
-        }
-        retVal = TRUE;
-    }
-    else if (message == WM_COMMAND)
-    {
-        if (LOWORD(wParam) == IDCANCEL)
-        {
-            ShowWindow(hwndDlg, SW_HIDE);
-            retVal = TRUE;
-        }
-    }
-    else if (message == WM_NOTIFY)
-    {
-        const LPNMHDR hdr = (LPNMHDR)lParam;
-        if (hdr->code == NM_CLICK || hdr->code == NM_RETURN)
-        {
-            const LITEM item = ((PNMLINK)lParam)->item;
-            if (item.szUrl != nullptr)
-            {
-                WindowsCommon::open(item.szUrl, hdr->idFrom != IDC_EDIT_CONFIG); // Edit config as admin user. Other - run as current user.
-            }
-        }
-    }
-
-    return retVal;
-}
-
-
-void LoaderApp::createAboutDialog()
-{
-    aboutDialog = CreateDialogParamW(MY_HINSTANCE, MAKEINTRESOURCE(IDD_ABOUT), getHwnd(),
-        aboutDialogProc, reinterpret_cast<LPARAM>(static_cast<ILoaderApp*>(this)));
-}
-
-
-void LoaderApp::showError(TranslationID errorText, bool needQuit)
-{
-    MessageBoxW(getHwnd(), translator.translate(errorText).c_str(), FileSystem::getExecutableName().c_str(), MB_OK | MB_ICONERROR);
-    if (needQuit)
-    {
-        PostQuitMessage(0);
-    }
-}
-
-
-void LoaderApp::onCreate()
-{
-    if (afterburner.init())
-    {
-        const std::wstring &preferredLanguage = afterburner.getPreferredLanguage();
-        if (!preferredLanguage.empty())
-        {
-            translator = Translator(preferredLanguage);
-        }
-
-        createMenu();
-        createAboutDialog();
-
-        trayIcon.addToTray();
-        trayIcon.setTooltip(translate(IDS_APP_NAME));
-
-        const uint32_t delaySeconds = afterburner.getStartupProfileDelay();
-        if (delaySeconds > 0 && taskScheduler.isTaskExist(kAutorunName))
-        {
-            SetTimer(getHwnd(), kStartupTimerId, delaySeconds * 1000, nullptr);
-        }
-        else
-        {
-            applyStartupProfile();
-        }
-    }
-    else
-    {
-        showError(IDS_ERROR_AFTERBURNER_INIT, true);
-    }
-}
-
-
-void LoaderApp::onMenu(HMENU submenu, uint16_t menuId)
-{
-    if (submenu == onStartMenu)
-    {
-        onStartupProfile(menuId);
-    }
-    else // Main menu.
-    {
-        const auto handler = kOnMenuHandlers.find(menuId);
-        if (handler != kOnMenuHandlers.end())
-        {
-            (this->*handler->second)(menuId);
-        }
-        else if (profilesMenuMap.count(menuId) > 0)
-        {
-            onApplyProfile(menuId);
-        }
-    }
-}
-
-
-void LoaderApp::onQuit(uint16_t)
-{
-    PostQuitMessage(0);
-}
-
-
-void LoaderApp::onAbout(uint16_t)
-{
-    if (aboutDialog != nullptr)
-    {
-        ShowWindow(aboutDialog, SW_SHOW);
-    }
-}
-
-
-void LoaderApp::onAutorun(uint16_t)
-{
-    const bool isInAutorun = taskScheduler.isTaskExist(kAutorunName)
-        ? !taskScheduler.removeTask(kAutorunName)
-        : taskScheduler.addTask(
-            kAutorunName, translator.translate(IDS_AUTORUN_INFO), FileSystem::getExecutablePath());
-
-    setMenuItemCheckedState(mainMenu, IDS_AUTORUN, isInAutorun);
-}
-
-
-void LoaderApp::onRunAfterburner(uint16_t)
-{
-    if (!afterburner.runAfterburner())
-    {
-        showError(IDS_ERROR_RUN_AFTERBURNER, false);
-    }
-}
-
-
-void LoaderApp::onApplyProfile(uint16_t menuId)
-{
-    isUserChangedProfile = true;
-
-    for (const auto &profile : profilesMenuMap)
-    {
-        bool isChecked = false;
-
-        if (menuId == profile.first)
-        {
-            if (applyProfile(profile.second))
-            {
-                isChecked = true;
-            }
-            else
-            {
-                showError(IDS_ERROR_PROFILE_APPLY, false);
-            }
-        }
-
-        setMenuItemCheckedState(mainMenu, profile.first, isChecked);
-    }
-}
-
-
-void LoaderApp::onStartupProfile(uint16_t menuId)
-{
-    const std::wstring &currentStartupProfile = afterburner.getStartupProfile();
-
-    for (const auto &profile : profilesMenuMap)
-    {
-        bool isChecked = false;
-        const uint16_t realProfileMenuItem = profile.first + kOnStartProfileMenuItemShift;
-
-        if (menuId == realProfileMenuItem)
-        {
-            if (profile.second == currentStartupProfile)
-            {
-                afterburner.removeStartupProfile();
-            }
-            else
-            {
-                isChecked = true;
-                afterburner.setStartupProfile(profile.second);
-            }
-        }
-
-        setMenuItemCheckedState(onStartMenu, realProfileMenuItem, isChecked);
-    }
-}
-
-
-bool LoaderApp::onEvent(UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-    return trayIcon.processEvents(uMsg, wParam, lParam);
-}
-
-
-void LoaderApp::onTimer(UINT timerId)
-{
-    if (timerId == kStartupTimerId)
-    {
-        if (!isUserChangedProfile)
-        {
-            applyStartupProfile();
-        }
-
-        KillTimer(getHwnd(), kStartupTimerId);
-    }
-}
-
-
-void LoaderApp::onTaskbarCreated()
-{
-    trayIcon.restoreInTray();
-}
-
-
-void LoaderApp::applyStartupProfile()
-{
-    applyProfile(afterburner.getStartupProfile());
-}
-
-
-bool LoaderApp::applyProfile(const std::wstring &profile)
-{
-    bool isSuccess = false;
-
-    if (!profile.empty() && afterburner.applyProfile(profile))
-    {
-        isSuccess = true;
-        trayIcon.setTooltip(translate(IDS_APP_NAME) + L"\n" + profile);
-    }
-
-    return isSuccess;
-}
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LoaderApp.h"
+#include "../resources/resource.h"
+#include "../utils/ConfigFile.h"
+#include "../utils/FileSystem.h"
+#include "../utils/Translator.h"
+#include "../utils/WindowsCommon.h"
+#include <Commctrl.h>
+#include <regex>
+
+
+namespace Loader
+{
+
+
+const wchar_t *kMainWindowClass = L"AfterburnerProfileLoaderMainClass";
+const wchar_t *kMainWindowName = L"AfterburnerProfileLoaderMainWindow";
+const std::wstring kAutorunName = L"AfterburnerProfileLoader";
+const UINT_PTR kStartupTimerId = 1025;
+const UINT_PTR kConfigSaveTimerId = 1026;
+const UINT_PTR kConfigReloadTimerId = 1027;
+const UINT kConfigReloadDelay = 500; // Milliseconds, editors can write the file several times on save.
+const UINT kConfigChangedMessage = WM_APP + 1;
+const UINT kApplyFinishedMessage = WM_APP + 2; // wParam: is timed out, lParam: apply operation.
+const DWORD kApplyTimedOutExitCode = WAIT_TIMEOUT;
+const UINT kProfilesMenuPosition = 3; // After 'On start' submenu, autorun item and separator.
+const uint16_t kInitialProfileMenuItemId = 20000;
+const uint16_t kOnStartProfileMenuItemShift = 1000;
+
+const std::map<uint16_t, LoaderApp::MenuHandler> LoaderApp::kOnMenuHandlers
+{
+    {IDS_QUIT,            &LoaderApp::onQuit},
+    {IDS_ABOUT,           &LoaderApp::onAbout},
+    {IDS_STATISTICS,      &LoaderApp::onStatistics},
+    {IDS_AUTORUN,         &LoaderApp::onAutorun},
+    {IDS_RUN_AFTERBURNER, &LoaderApp::onRunAfterburner}
+};
+
+
+LoaderApp::LoaderApp()
+    : trayIcon(this)
+    , lastApplyResult{std::wstring(), 0, 0, false}
+    , isUserChangedProfile(false)
+    , mainMenu(nullptr)
+    , onStartMenu(nullptr)
+    , aboutDialog(nullptr)
+{}
+
+
+bool LoaderApp::start()
+{
+    stop();
+
+    return create(kMainWindowClass, kMainWindowName, this);
+}
+
+
+void LoaderApp::stop()
+{
+    destroy();
+}
+
+
+HWND LoaderApp::getHwnd()
+{
+    return getWindowHandle();
+}
+
+
+void LoaderApp::onDestroy()
+{
+    configWatcher.stop();
+    cancelApply();
+    KillTimer(getHwnd(), kConfigReloadTimerId);
+    KillTimer(getHwnd(), kConfigSaveTimerId);
+    afterburner.flushConfig();
+    applyStatistics.dump(afterburner.getStatisticsFilePath());
+
+    trayIcon.removeFromTray();
+
+    if (aboutDialog)
+    {
+        DestroyWindow(aboutDialog);
+        aboutDialog = nullptr;
+    }
+}
+
+
+void LoaderApp::onIconContextMenu(const POINT &position)
+{
+    showContextMenu(position, mainMenu);
+}
+
+
+const std::wstring& LoaderApp::translate(TranslationID id)
+{
+    return translator.translate(id);
+}
+
+
+void LoaderApp::createMenu()
+{
+    HMENU root = CreateMenu();
+    mainMenu = CreatePopupMenu();
+    onStartMenu = CreatePopupMenu();
+
+    appendMenu(mainMenu, onStartMenu, IDS_ONSTART);
+    appendMenuCheckBox(mainMenu, IDS_AUTORUN, taskScheduler.isTaskExist(kAutorunName));
+    appendMenuSeparator(mainMenu);
+
+    const auto configState = afterburner.getConfigState();
+
+    for (const auto &profile : configState->enabledProfiles)
+    {
+        // Menu id depends on profile id only, so it stays the same after config reload.
+        const uint16_t profileMenuId = kInitialProfileMenuItemId + (uint16_t)profile.second;
+
+        profilesMenuMap.emplace(profileMenuId, profile.first);
+        const bool isProfileOnStartup = profile.first == configState->startupProfile;
+
+        appendMenuCheckBox(mainMenu, profileMenuId, profile.first, isProfileOnStartup);
+        appendMenuCheckBox(onStartMenu, profileMenuId + kOnStartProfileMenuItemShift, profile.first, isProfileOnStartup);
+    }
+
+    if (configState->settings.isRunAfterburnerMenuEnabled)
+    {
+        appendMenuSeparator(mainMenu);
+        appendMenu(mainMenu, IDS_RUN_AFTERBURNER);
+    }
+
+    appendMenuSeparator(mainMenu);
+    appendMenu(mainMenu, IDS_STATISTICS);
+    appendMenu(mainMenu, IDS_ABOUT);
+    appendMenu(mainMenu, IDS_QUIT);
+    appendMenu(root, mainMenu, 0);
+
+    SetMenu(getHwnd(), root);
+}
+
+
+void LoaderApp::updateProfilesMenu()
+{
+    const auto configState = afterburner.getConfigState();
+    const auto &enabledProfiles = configState->enabledProfiles;
+    std::map<uint16_t, std::wstring> newProfilesMenuMap;
+
+    for (const auto &profile : enabledProfiles)
+    {
+        newProfilesMenuMap.emplace(kInitialProfileMenuItemId + (uint16_t)profile.second, profile.first);
+    }
+
+    // Remove items of disabled and renamed profiles, renamed ones keep their checked state.
+    std::map<uint16_t, bool> renamedCheckedStates;
+
+    for (const auto &item : profilesMenuMap)
+    {
+        const auto newItem = newProfilesMenuMap.find(item.first);
+        if (newItem == newProfilesMenuMap.end() || newItem->second != item.second)
+        {
+            if (newItem != newProfilesMenuMap.end())
+            {
+                renamedCheckedStates.emplace(item.first, isMenuItemChecked(mainMenu, item.first));
+            }
+
+            removeMenuItem(mainMenu, item.first);
+            removeMenuItem(onStartMenu, item.first + kOnStartProfileMenuItemShift);
+        }
+    }
+
+    // Insert new and renamed items keeping menu sorted by profile name.
+    const std::wstring &startupProfile = configState->startupProfile;
+    UINT position = 0;
+
+    for (const auto &profile : enabledProfiles)
+    {
+        const uint16_t profileMenuId = kInitialProfileMenuItemId + (uint16_t)profile.second;
+        const uint16_t startupMenuId = profileMenuId + kOnStartProfileMenuItemShift;
+        const auto prevItem = profilesMenuMap.find(profileMenuId);
+
+        if (prevItem == profilesMenuMap.end() || prevItem->second != profile.first)
+        {
+            const auto checkedState = renamedCheckedStates.find(profileMenuId);
+
+            insertMenuCheckBox(mainMenu, kProfilesMenuPosition + position, profileMenuId, profile.first,
+                checkedState != renamedCheckedStates.end() && checkedState->second);
+            insertMenuCheckBox(onStartMenu, position, startupMenuId, profile.first, false);
+        }
+
+        setMenuItemCheckedState(onStartMenu, startupMenuId, profile.first == startupProfile);
+        position++;
+    }
+
+    profilesMenuMap = std::move(newProfilesMenuMap);
+}
+
+
+void LoaderApp::startConfigWatcher()
+{
+    const std::wstring configPath = AfterburnerController::getConfigFilePath();
+    const std::wstring configDirPath = FileSystem::getDirWithoutFile(configPath);
+    const HWND window = getHwnd();
+
+    if (!configDirPath.empty())
+    {
+        configWatcher.start(configDirPath, configPath.substr(configDirPath.size() + 1), [window]()
+        {
+            PostMessage(window, kConfigChangedMessage, 0, 0);
+        });
+    }
+}
+
+
+static INT_PTR CALLBACK aboutDialogProc(HWND hwndDlg, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    INT_PTR retVal = FALSE;
+
+    if (message == WM_INITDIALOG)
+    {
+        ILoaderApp *app = reinterpret_cast<ILoaderApp *>(lParam);
+        if (app)
+        {
+            const HICON icon = (HICON)LoadImageW(MY_HINSTANCE, MAKEINTRESOURCEW(IDI_SMALL), IMAGE_ICON,
+                GetSystemMetrics(SM_CXSMICON), GetSystemMetrics(SM_CYSMICON), 0);
+
+            if (icon)
+            {
+                SendMessage(hwndDlg, WM_SETICON, ICON_SMALL, (LPARAM)icon);
+            }
+            SetWindowText(hwndDlg, app->translate(IDS_ABOUT).c_str());
+            SetDlgItemTextW(hwndDlg, IDC_APP_NAME, app->translate(IDS_APP_NAME).c_str());
+            SetDlgItemTextW(hwndDlg, IDC_APP_VERSION, WindowsCommon::getAppVersion(FileSystem::getExecutablePath()).c_str());
+            SetDlgItemTextW(hwndDlg, IDC_EDIT_CONFIG,
+                std::regex_replace(app->translate(IDS_EDIT_CONFIG),
+                    std::wregex(L"<a>"), L"<a href=\"" + AfterburnerController::getConfigFilePath() + L"\">").c_str());
+            SetDlgItemTextW(hwndDlg, IDC_SOURCE_CODE, app->translate(IDS_SOURCE_CODE).c_str());
+            SetDlgItemTextW(hwndDlg, IDC_RELEASES, app->translate(IDS_RELEASES).c_str());
+            SetDlgItemTextW(hwndDlg, IDC_LICENSE, app->translate(IDS_LICENSE).c_str());
+        }
+        retVal = TRUE;
+    }
+    else if (message == WM_COMMAND)
+    {
+        if (LOWORD(wParam) == IDCANCEL)
+        {
+            ShowWindow(hwndDlg, SW_HIDE);
+            retVal = TRUE;
+        }
+    }
+    else if (message == WM_NOTIFY)
+    {
+        const LPNMHDR hdr = (LPNMHDR)lParam;
+        if (hdr->code == NM_CLICK || hdr->code == NM_RETURN)
+        {
+            const LITEM item = ((PNMLINK)lParam)->item;
+            if (item.szUrl != nullptr)
+            {
+                WindowsCommon::open(item.szUrl, hdr->idFrom != IDC_EDIT_CONFIG); // Edit config as admin user. Other - run as current user.
+            }
+        }
+    }
+
+    return retVal;
+}
+
+
+void LoaderApp::createAboutDialog()
+{
+    aboutDialog = CreateDialogParamW(MY_HINSTANCE, MAKEINTRESOURCE(IDD_ABOUT), getHwnd(),
+        aboutDialogProc, reinterpret_cast<LPARAM>(static_cast<ILoaderApp*>(this)));
+}
+
+
+void LoaderApp::showError(TranslationID errorText, bool needQuit)
+{
+    MessageBoxW(getHwnd(), translator.translate(errorText).c_str(), FileSystem::getExecutableName().c_str(), MB_OK | MB_ICONERROR);
+    if (needQuit)
+    {
+        PostQuitMessage(0);
+    }
+}
+
+
+void LoaderApp::onCreate()
+{
+    if (afterburner.init())
+    {
+        const auto configState = afterburner.getConfigState();
+        const std::wstring &preferredLanguage = configState->settings.preferredLanguage;
+        if (!preferredLanguage.empty())
+        {
+            translator = Translator(preferredLanguage);
+        }
+
+        createMenu();
+        createAboutDialog();
+        startConfigWatcher();
+
+        trayIcon.addToTray();
+        trayIcon.setTooltip(translate(IDS_APP_NAME));
+
+        scheduleConfigSave();
+
+        const uint32_t delaySeconds = (uint32_t)configState->settings.startupProfileDelay;
+        if (delaySeconds > 0 && taskScheduler.isTaskExist(kAutorunName))
+        {
+            SetTimer(getHwnd(), kStartupTimerId, delaySeconds * 1000, nullptr);
+        }
+        else
+        {
+            applyStartupProfile();
+        }
+    }
+    else
+    {
+        showError(IDS_ERROR_AFTERBURNER_INIT, true);
+    }
+}
+
+
+void LoaderApp::onMenu(HMENU submenu, uint16_t menuId)
+{
+    if (submenu == onStartMenu)
+    {
+        onStartupProfile(menuId);
+    }
+    else // Main menu.
+    {
+        const auto handler = kOnMenuHandlers.find(menuId);
+        if (handler != kOnMenuHandlers.end())
+        {
+            (this->*handler->second)(menuId);
+        }
+        else if (profilesMenuMap.count(menuId) > 0)
+        {
+            onApplyProfile(menuId);
+        }
+    }
+}
+
+
+void LoaderApp::onQuit(uint16_t)
+{
+    PostQuitMessage(0);
+}
+
+
+void LoaderApp::onAbout(uint16_t)
+{
+    if (aboutDialog != nullptr)
+    {
+        ShowWindow(aboutDialog, SW_SHOW);
+    }
+}
+
+
+void LoaderApp::onStatistics(uint16_t)
+{
+    applyStatistics.dump(afterburner.getStatisticsFilePath());
+
+    MessageBoxW(getHwnd(), formatStatistics().c_str(), translate(IDS_STATISTICS).c_str(), MB_OK | MB_ICONINFORMATION);
+}
+
+
+void LoaderApp::onAutorun(uint16_t)
+{
+    const bool isInAutorun = taskScheduler.isTaskExist(kAutorunName)
+        ? !taskScheduler.removeTask(kAutorunName)
+        : taskScheduler.addTask(
+            kAutorunName, translator.translate(IDS_AUTORUN_INFO), FileSystem::getExecutablePath());
+
+    setMenuItemCheckedState(mainMenu, IDS_AUTORUN, isInAutorun);
+}
+
+
+void LoaderApp::onRunAfterburner(uint16_t)
+{
+    if (!afterburner.runAfterburner())
+    {
+        showError(IDS_ERROR_RUN_AFTERBURNER, false);
+    }
+}
+
+
+void LoaderApp::onApplyProfile(uint16_t menuId)
+{
+    isUserChangedProfile = true;
+
+    const auto profile = profilesMenuMap.find(menuId);
+    if (profile != profilesMenuMap.end())
+    {
+        // Click on the checked item reapplies the profile, even if it looks applied.
+        requestApply(profile->second, menuId, ApplyPriority::User, isMenuItemChecked(mainMenu, menuId));
+    }
+}
+
+
+void LoaderApp::onStartupProfile(uint16_t menuId)
+{
+    // Snapshot keeps the name taken before the change below.
+    const auto configState = afterburner.getConfigState();
+    const std::wstring &currentStartupProfile = configState->startupProfile;
+
+    for (const auto &profile : profilesMenuMap)
+    {
+        bool isChecked = false;
+        const uint16_t realProfileMenuItem = profile.first + kOnStartProfileMenuItemShift;
+
+        if (menuId == realProfileMenuItem)
+        {
+            if (profile.second == currentStartupProfile)
+            {
+                afterburner.removeStartupProfile();
+            }
+            else
+            {
+                isChecked = true;
+                afterburner.setStartupProfile(profile.second);
+            }
+        }
+
+        setMenuItemCheckedState(onStartMenu, realProfileMenuItem, isChecked);
+    }
+
+    scheduleConfigSave();
+}
+
+
+bool LoaderApp::onEvent(UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    bool isProcessed = false;
+
+    if (uMsg == kConfigChangedMessage)
+    {
+        // Restarted on every notification, so a burst of writes ends with a single reload.
+        SetTimer(getHwnd(), kConfigReloadTimerId, kConfigReloadDelay, nullptr);
+        isProcessed = true;
+    }
+    else if (uMsg == kApplyFinishedMessage)
+    {
+        onApplyFinished(reinterpret_cast<const ApplyOperation*>(lParam), wParam != 0);
+        isProcessed = true;
+    }
+    else if (uMsg == WM_POWERBROADCAST)
+    {
+        // GPU settings can be reset by sleep, the profile must really be applied again after resume.
+        if (wParam == PBT_APMRESUMEAUTOMATIC || wParam == PBT_APMRESUMESUSPEND)
+        {
+            afterburner.invalidateAppliedProfile();
+        }
+    }
+    else
+    {
+        isProcessed = trayIcon.processEvents(uMsg, wParam, lParam);
+    }
+
+    return isProcessed;
+}
+
+
+void LoaderApp::onTimer(UINT timerId)
+{
+    if (timerId == kStartupTimerId)
+    {
+        if (!isUserChangedProfile)
+        {
+            applyStartupProfile();
+        }
+
+        KillTimer(getHwnd(), kStartupTimerId);
+    }
+    else if (timerId == kConfigSaveTimerId)
+    {
+        KillTimer(getHwnd(), kConfigSaveTimerId);
+        afterburner.flushConfig();
+    }
+    else if (timerId == kConfigReloadTimerId)
+    {
+        KillTimer(getHwnd(), kConfigReloadTimerId);
+
+        if (afterburner.reloadConfig())
+        {
+            updateProfilesMenu();
+        }
+    }
+}
+
+
+void LoaderApp::onTaskbarCreated()
+{
+    trayIcon.restoreInTray();
+}
+
+
+void LoaderApp::applyStartupProfile()
+{
+    const auto configState = afterburner.getConfigState();
+    const std::wstring &profile = configState->startupProfile;
+
+    if (!profile.empty())
+    {
+        requestApply(profile, 0, ApplyPriority::Automatic, false);
+    }
+}
+
+
+void LoaderApp::scheduleConfigSave()
+{
+    if (afterburner.hasPendingConfigChanges())
+    {
+        const uint32_t delayMs = afterburner.getConfigWriteBack().getQuietPeriod();
+        if (delayMs > 0)
+        {
+            // Timer with the same id is restarted, so a burst of changes ends with a single save.
+            SetTimer(getHwnd(), kConfigSaveTimerId, delayMs, nullptr);
+        }
+        else
+        {
+            afterburner.flushConfig();
+        }
+    }
+}
+
+
+const LoaderApp::ApplyResult& LoaderApp::getLastApplyResult() const
+{
+    return lastApplyResult;
+}
+
+
+const ApplyQueue& LoaderApp::getApplyQueue() const
+{
+    return applyQueue;
+}
+
+
+const ApplyStatistics& LoaderApp::getApplyStatistics() const
+{
+    return applyStatistics;
+}
+
+
+void LoaderApp::requestApply(const std::wstring &profile, uint16_t menuId, ApplyPriority priority, bool isForced)
+{
+    const ApplyRequest request{profile, menuId, priority, isForced};
+
+    if (applyQueue.push(request))
+    {
+        startApply(request);
+    }
+}
+
+
+void LoaderApp::startApply(const ApplyRequest &request)
+{
+    const uint64_t stateGeneration = afterburner.getAppliedStateGeneration();
+    const bool isAlreadyApplied = applyQueue.skipIfApplied(request,
+        [this](const std::wstring &profile) { return afterburner.isProfileApplied(profile); });
+    HANDLE process = nullptr;
+    bool isStarted = isAlreadyApplied || afterburner.applyProfile(request.profile, &process);
+    bool isAwaited = false;
+
+    if (!isAlreadyApplied && isStarted)
+    {
+        const auto configState = afterburner.getConfigState();
+        const WindowsCommon::ExecTimings &timings = afterburner.getLastExecTimings();
+        applyStatistics.record(ApplyStage::FileLock, timings.openMicroseconds);
+        applyStatistics.record(ApplyStage::SignatureCheck, timings.hashMicroseconds + timings.verifyMicroseconds);
+        applyStatistics.record(ApplyStage::ProcessSpawn, timings.launchMicroseconds);
+
+        runningApply.reset(new ApplyOperation{getHwnd(), request, stateGeneration, process, nullptr,
+            std::chrono::steady_clock::now()});
+
+        isAwaited = RegisterWaitForSingleObject(&runningApply->wait, process, onApplyProcessExit, runningApply.get(),
+            (uint32_t)configState->settings.applyTimeout, WT_EXECUTEONLYONCE) != FALSE;
+
+        if (!isAwaited)
+        {
+            CloseHandle(process);
+            runningApply.reset();
+        }
+    }
+
+    // Without a wait the result is unknown, the successful start is trusted as it is.
+    if (!isAwaited)
+    {
+        completeApply(request, isStarted);
+    }
+}
+
+
+VOID CALLBACK LoaderApp::onApplyProcessExit(PVOID context, BOOLEAN isTimedOut)
+{
+    // Thread pool thread: the result is handled on the UI thread.
+    const ApplyOperation *operation = static_cast<const ApplyOperation*>(context);
+    PostMessage(operation->window, kApplyFinishedMessage, isTimedOut ? 1 : 0, reinterpret_cast<LPARAM>(context));
+}
+
+
+void LoaderApp::onApplyFinished(const ApplyOperation *operation, bool isTimedOut)
+{
+    if (runningApply && runningApply.get() == operation)
+    {
+        // Waits for the callback to return, so the operation is not used after it is destroyed.
+        UnregisterWaitEx(runningApply->wait, INVALID_HANDLE_VALUE);
+
+        DWORD exitCode = kApplyTimedOutExitCode;
+
+        if (isTimedOut)
+        {
+            TerminateProcess(runningApply->process, kApplyTimedOutExitCode);
+        }
+        else if (!GetExitCodeProcess(runningApply->process, &exitCode))
+        {
+            exitCode = (DWORD)-1;
+        }
+
+        CloseHandle(runningApply->process);
+
+        const uint64_t durationUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - runningApply->startTime).count();
+
+        lastApplyResult.profile = runningApply->request.profile;
+        lastApplyResult.exitCode = exitCode;
+        lastApplyResult.durationMs = (uint32_t)(durationUs / 1000);
+        lastApplyResult.isTimedOut = isTimedOut;
+
+        applyStatistics.record(ApplyStage::ProcessExit, durationUs < UINT32_MAX ? (uint32_t)durationUs : UINT32_MAX);
+
+        const bool isApplied = !isTimedOut && exitCode == 0;
+
+        if (isApplied)
+        {
+            afterburner.confirmAppliedProfile(runningApply->request.profile, runningApply->stateGeneration);
+        }
+        else
+        {
+            afterburner.invalidateAppliedProfile();
+        }
+
+        const ApplyRequest request = std::move(runningApply->request);
+        runningApply.reset();
+
+        completeApply(request, isApplied);
+    }
+}
+
+
+void LoaderApp::completeApply(const ApplyRequest &request, bool isApplied)
+{
+    ApplyRequest nextRequest{std::wstring(), 0, ApplyPriority::Automatic, false};
+
+    // Result of a superseded apply is not shown: the pending request is started right away.
+    if (applyQueue.finish(&nextRequest))
+    {
+        startApply(nextRequest);
+    }
+    else
+    {
+        commitApply(request, isApplied);
+    }
+}
+
+
+void LoaderApp::commitApply(const ApplyRequest &request, bool isApplied)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (isApplied)
+    {
+        trayIcon.setTooltip(translate(IDS_APP_NAME) + L"\n" + request.profile);
+    }
+
+    // Menu reflects user choices only, failed automatic apply is silent.
+    if (request.priority == ApplyPriority::User)
+    {
+        for (const auto &item : profilesMenuMap)
+        {
+            setMenuItemCheckedState(mainMenu, item.first, isApplied && item.first == request.menuId);
+        }
+    }
+
+    // Modal error box is not a part of the update.
+    applyStatistics.record(ApplyStage::UiUpdate, (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+
+    if (request.priority == ApplyPriority::User && !isApplied)
+    {
+        showError(IDS_ERROR_PROFILE_APPLY, false);
+    }
+}
+
+
+std::wstring LoaderApp::formatStatistics()
+{
+    const SignatureCache &signatureCache = afterburner.getSignatureCache();
+
+    ApplyStatistics::Labels labels;
+    labels.stageNames[(size_t)ApplyStage::FileLock] = translate(IDS_STATISTICS_FILE_LOCK);
+    labels.stageNames[(size_t)ApplyStage::SignatureCheck] = translate(IDS_STATISTICS_SIGNATURE_CHECK);
+    labels.stageNames[(size_t)ApplyStage::ProcessSpawn] = translate(IDS_STATISTICS_PROCESS_SPAWN);
+    labels.stageNames[(size_t)ApplyStage::ProcessExit] = translate(IDS_STATISTICS_PROCESS_EXIT);
+    labels.stageNames[(size_t)ApplyStage::UiUpdate] = translate(IDS_STATISTICS_UI_UPDATE);
+    labels.min = translate(IDS_STATISTICS_MIN);
+    labels.mean = translate(IDS_STATISTICS_MEAN);
+    labels.max = translate(IDS_STATISTICS_MAX);
+    labels.unit = translate(IDS_STATISTICS_MICROSECONDS);
+
+    return applyStatistics.format(labels) +
+        L"\n" + translate(IDS_STATISTICS_APPLIES) + L": " + std::to_wstring(applyQueue.getStartedRequests()) +
+        L", " + translate(IDS_STATISTICS_SKIPPED) + L" " + std::to_wstring(applyQueue.getSkippedRequests()) +
+        L", " + translate(IDS_STATISTICS_SUPERSEDED) + L" " + std::to_wstring(applyQueue.getSupersededRequests()) +
+        L", " + translate(IDS_STATISTICS_DROPPED) + L" " + std::to_wstring(applyQueue.getDroppedRequests()) +
+        L", " + translate(IDS_STATISTICS_SAVED_SPAWNS) + L" " + std::to_wstring(applyQueue.getSavedSpawns()) +
+        L"\n" + translate(IDS_STATISTICS_SIGNATURE_CACHE) + L": " +
+        translate(IDS_STATISTICS_HITS) + L" " + std::to_wstring(signatureCache.getHits()) +
+        L", " + translate(IDS_STATISTICS_MISSES) + L" " + std::to_wstring(signatureCache.getMisses()) +
+        L", " + translate(IDS_STATISTICS_REJECTED) + L" " + std::to_wstring(signatureCache.getRejected()) +
+        L"\n\n" + afterburner.getStatisticsFilePath();
+}
+
+
+void LoaderApp::cancelApply()
+{
+    // Started instance is left running, only its wait is dropped.
+    if (runningApply)
+    {
+        UnregisterWaitEx(runningApply->wait, INVALID_HANDLE_VALUE);
+        CloseHandle(runningApply->process);
+        runningApply.reset();
+    }
+}
+
 }
\ No newline at end of file
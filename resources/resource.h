@@ -1,42 +1,61 @@
-//{{NO_DEPENDENCIES}}
-// Microsoft Visual C++ generated include file.
-// Used by resource.rc
-//
-#define IDD_ABOUT                       101
-#define IDS_APP_TITLE                   103
-#define IDI_SMALL                       108
-#define IDI_NOTIFICATION                138
-#define IDS_QUIT                        147
-#define IDS_ONSTART                     148
-#define IDS_ERROR_AFTERBURNER_INIT      149
-#define IDS_ABOUT                       150
-#define IDS_ERROR_PROFILE_APPLY         151
-#define IDS_RUN_AFTERBURNER             152
-#define IDS_RUN_AFTERBURNER_ERROR       153
-#define IDS_ERROR_RUN_AFTERBURNER       153
-#define IDS_APP_NAME                    154
-#define IDS_EDIT_CONFIG                 155
-#define IDS_SOURCE_CODE                 156
-#define IDS_RELEASES                    157
-#define IDS_LICENSE                     158
-#define IDS_AUTORUN                     160
-#define IDS_AUTORUN_INFO                162
-#define IDC_EDIT_CONFIG                 1003
-#define IDC_SOURCE_CODE                 1004
-#define IDC_RELEASES                    1005
-#define IDC_LICENSE                     1006
-#define IDC_APP_NAME                    1007
-#define IDC_APP_VERSION                 1008
-#define IDC_STATIC                      -1
-
-// Next default values for new objects
-//
-#ifdef APSTUDIO_INVOKED
-#ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NO_MFC                     1
-#define _APS_NEXT_RESOURCE_VALUE        144
-#define _APS_NEXT_COMMAND_VALUE         32771
-#define _APS_NEXT_CONTROL_VALUE         1009
-#define _APS_NEXT_SYMED_VALUE           110
-#endif
-#endif
+//{{NO_DEPENDENCIES}}
+// Microsoft Visual C++ generated include file.
+// Used by resource.rc
+//
+#define IDD_ABOUT                       101
+#define IDS_APP_TITLE                   103
+#define IDI_SMALL                       108
+#define IDI_NOTIFICATION                138
+#define IDS_QUIT                        147
+#define IDS_ONSTART                     148
+#define IDS_ERROR_AFTERBURNER_INIT      149
+#define IDS_ABOUT                       150
+#define IDS_ERROR_PROFILE_APPLY         151
+#define IDS_RUN_AFTERBURNER             152
+#define IDS_RUN_AFTERBURNER_ERROR       153
+#define IDS_ERROR_RUN_AFTERBURNER       153
+#define IDS_APP_NAME                    154
+#define IDS_EDIT_CONFIG                 155
+#define IDS_SOURCE_CODE                 156
+#define IDS_RELEASES                    157
+#define IDS_LICENSE                     158
+#define IDS_AUTORUN                     160
+#define IDS_AUTORUN_INFO                162
+#define IDS_STATISTICS                  163
+#define IDS_STATISTICS_FILE_LOCK        164
+#define IDS_STATISTICS_SIGNATURE_CHECK  165
+#define IDS_STATISTICS_PROCESS_SPAWN    166
+#define IDS_STATISTICS_PROCESS_EXIT     167
+#define IDS_STATISTICS_UI_UPDATE        168
+#define IDS_STATISTICS_MIN              169
+#define IDS_STATISTICS_MEAN             170
+#define IDS_STATISTICS_MAX              171
+#define IDS_STATISTICS_MICROSECONDS     172
+#define IDS_STATISTICS_APPLIES          173
+#define IDS_STATISTICS_SKIPPED          174
+#define IDS_STATISTICS_SUPERSEDED       175
+#define IDS_STATISTICS_DROPPED          176
+#define IDS_STATISTICS_SIGNATURE_CACHE  177
+#define IDS_STATISTICS_HITS             178
+#define IDS_STATISTICS_MISSES           179
+#define IDS_STATISTICS_REJECTED         180
+#define IDS_STATISTICS_SAVED_SPAWNS     181
+#define IDC_EDIT_CONFIG                 1003
+#define IDC_SOURCE_CODE                 1004
+#define IDC_RELEASES                    1005
+#define IDC_LICENSE                     1006
+#define IDC_APP_NAME                    1007
+#define IDC_APP_VERSION                 1008
+#define IDC_STATIC                      -1
+
+// Next default values for new objects
+//
+#ifdef APSTUDIO_INVOKED
+#ifndef APSTUDIO_READONLY_SYMBOLS
+#define _APS_NO_MFC                     1
+#define _APS_NEXT_RESOURCE_VALUE        144
+#define _APS_NEXT_COMMAND_VALUE         32771
+#define _APS_NEXT_CONTROL_VALUE         1009
+#define _APS_NEXT_SYMED_VALUE           110
+#endif
+#endif
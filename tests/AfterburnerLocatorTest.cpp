@@ -0,0 +1,142 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../loader/AfterburnerLocator.h"
+#include <chrono>
+#include <map>
+#include <thread>
+
+
+using namespace Loader;
+
+
+// Folders with a probe delay in milliseconds, every known folder is valid.
+// Read concurrently by probes, so it is not changed after the search starts.
+class FakeLocatorBackend : public IAfterburnerLocatorBackend
+{
+public:
+    std::vector<std::wstring> getRegisteredDirs() override { return registeredDirs; }
+    std::vector<std::wstring> getDefaultDirs() override { return defaultDirs; }
+
+    std::wstring probeDir(const std::wstring &dirPath) override
+    {
+        const auto it = dirs.find(dirPath);
+
+        if (it != dirs.end())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(it->second));
+        }
+
+        return it != dirs.end() ? dirPath + L"/MSIAfterburner.exe" : std::wstring();
+    }
+
+    std::map<std::wstring, uint32_t> dirs;
+    std::vector<std::wstring> registeredDirs;
+    std::vector<std::wstring> defaultDirs;
+};
+
+
+static uint32_t getElapsedMs(std::chrono::steady_clock::time_point startTime)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+TEST_CASE(preferredFolderWinsOverCheaperGroups)
+{
+    const auto backend = std::make_shared<FakeLocatorBackend>();
+    backend->dirs = {{L"/configured", 0}, {L"/registered", 0}};
+    backend->registeredDirs = {L"/registered"};
+
+    AfterburnerLocator locator(backend, 1000);
+    CHECK(locator.find({L"/configured", L"/exe"}) == L"/configured/MSIAfterburner.exe");
+    CHECK(locator.getStartedProbes() == 1);
+}
+
+
+TEST_CASE(groupsAreAskedInOrderAndFoldersOnce)
+{
+    const auto backend = std::make_shared<FakeLocatorBackend>();
+    backend->dirs = {{L"/default", 0}};
+    backend->registeredDirs = {L"/missing", L"/exe"};
+    backend->defaultDirs = {L"/exe", L"/default", L""};
+
+    AfterburnerLocator locator(backend, 1000);
+    CHECK(locator.find({L"/exe", L""}) == L"/default/MSIAfterburner.exe");
+    CHECK(locator.getStartedProbes() == 3); // '/exe' is probed once, empty folders never.
+    CHECK(locator.getTimedOutProbes() == 0);
+    CHECK(locator.collectLateResult(0).empty());
+}
+
+
+TEST_CASE(slowPreferredFolderIsWaitedForBeforeGivingUp)
+{
+    const auto backend = std::make_shared<FakeLocatorBackend>();
+    backend->dirs = {{L"/slow", 300}};
+
+    AfterburnerLocator locator(backend, 50);
+    CHECK(locator.find({L"/slow"}).empty());
+    CHECK(locator.getTimedOutProbes() == 1);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    CHECK(locator.collectLateResult(5000) == L"/slow/MSIAfterburner.exe");
+    CHECK(getElapsedMs(startTime) < 2000); // Returns as soon as the probe finishes.
+    CHECK(locator.getLateResults() == 1);
+}
+
+
+TEST_CASE(lateResultIsCollectedWithoutWaiting)
+{
+    const auto backend = std::make_shared<FakeLocatorBackend>();
+    backend->dirs = {{L"/slow", 200}, {L"/hanging", 60000}};
+    backend->registeredDirs = {L"/hanging"};
+
+    // Configured folder times out, but finishes while the registered one is probed.
+    AfterburnerLocator locator(backend, 150);
+    CHECK(locator.find({L"/slow"}).empty());
+    CHECK(locator.getTimedOutProbes() == 2);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    CHECK(locator.collectLateResult(0) == L"/slow/MSIAfterburner.exe");
+    CHECK(getElapsedMs(startTime) < 100);
+}
+
+
+TEST_CASE(hangingProbesAreNotWaitedForLonger)
+{
+    const auto backend = std::make_shared<FakeLocatorBackend>();
+    backend->dirs = {{L"/hanging", 60000}, {L"/hanging2", 60000}};
+    backend->registeredDirs = {L"/hanging2"};
+
+    AfterburnerLocator locator(backend, 20);
+    CHECK(locator.find({L"/hanging"}).empty());
+
+    // One timeout is shared by all abandoned groups.
+    const auto startTime = std::chrono::steady_clock::now();
+    CHECK(locator.collectLateResult(100).empty());
+    const uint32_t elapsed = getElapsedMs(startTime);
+    CHECK(elapsed >= 90 && elapsed < 1000);
+    CHECK(locator.getLateResults() == 0);
+}
+
+
+TEST_MAIN()
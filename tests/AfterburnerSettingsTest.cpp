@@ -0,0 +1,162 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../loader/AfterburnerSettings.h"
+
+
+using namespace Loader;
+
+
+struct IntSettingCase
+{
+    std::wstring_view key;
+    int32_t AfterburnerSettings::*field;
+    int32_t defaultValue; // Of a missing key.
+    int32_t newFileValue; // Written to a new config file.
+    int32_t minValue;
+    int32_t maxValue;
+    bool isClamped;       // Out of range value is clamped, otherwise it is reset to the default.
+};
+
+
+const IntSettingCase kIntSettings[] =
+{
+    {kConfigKeyStartupProfileDelay, &AfterburnerSettings::startupProfileDelay, 0, 5, 0, 120, true},
+    {kConfigKeyStartupProfileId, &AfterburnerSettings::startupProfileId, kInvalidProfileId, kInvalidProfileId, 1, (int32_t)kProfilesCount, false},
+    {kConfigKeyConfigSaveDelay, &AfterburnerSettings::configSaveDelay, 2000, 2000, 0, 60000, true},
+    {kConfigKeyApplyTimeout, &AfterburnerSettings::applyTimeout, 30000, 30000, 1000, 600000, true}
+};
+
+
+// User config in memory over the fallbacks, like the controller layers them without the machine file.
+struct SettingsConfig
+{
+    ConfigFile<std::wstring> user;
+    ConfigFile<std::wstring> fallbacks;
+    LayeredConfig<std::wstring> config;
+
+    SettingsConfig()
+    {
+        AfterburnerSettings::writeFallbacks(&fallbacks);
+        config.setLayers(&user, {&fallbacks});
+    }
+
+    AfterburnerSettings load() const
+    {
+        AfterburnerSettings settings;
+        settings.load(config);
+        return settings;
+    }
+};
+
+
+TEST_CASE(missingKeysTakeDefaults)
+{
+    const AfterburnerSettings constructed;
+    const AfterburnerSettings loaded = SettingsConfig().load();
+
+    for (const auto &setting : kIntSettings)
+    {
+        CHECK(constructed.*setting.field == setting.defaultValue);
+        CHECK(loaded.*setting.field == setting.defaultValue);
+    }
+
+    CHECK(loaded.isRunAfterburnerMenuEnabled);
+    CHECK(loaded.afterburnerDirPath.empty());
+    CHECK(loaded.afterburnerSha256.empty());
+    CHECK(loaded.preferredLanguage.empty());
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        CHECK(loaded.profiles[i].name == L"Profile " + std::to_wstring(i + 1));
+        CHECK(!loaded.profiles[i].isEnabled);
+        CHECK(constructed.profiles[i].name == loaded.profiles[i].name);
+    }
+}
+
+
+TEST_CASE(newConfigFileHasDefaultTexts)
+{
+    SettingsConfig settingsConfig;
+    AfterburnerSettings::writeDefaults(&settingsConfig.user);
+
+    const AfterburnerSettings loaded = settingsConfig.load();
+
+    for (const auto &setting : kIntSettings)
+    {
+        CHECK(loaded.*setting.field == setting.newFileValue);
+    }
+
+    CHECK(settingsConfig.user.getValue(kConfigSectionMain, kConfigKeyStartupProfileId).empty());
+    CHECK(loaded.isRunAfterburnerMenuEnabled);
+
+    for (size_t i = 0; i < kProfilesCount; ++i)
+    {
+        CHECK(loaded.profiles[i].name == L"Profile " + std::to_wstring(i + 1));
+        CHECK(loaded.profiles[i].isEnabled);
+    }
+}
+
+
+TEST_CASE(valuesOutOfRangeAreClampedOrReset)
+{
+    for (const auto &setting : kIntSettings)
+    {
+        SettingsConfig settingsConfig;
+
+        const int32_t inRange[] = {setting.minValue, setting.maxValue};
+        for (const int32_t value : inRange)
+        {
+            settingsConfig.user.setValue(kConfigSectionMain, setting.key, value);
+            CHECK(settingsConfig.load().*setting.field == value);
+        }
+
+        settingsConfig.user.setValue(kConfigSectionMain, setting.key, setting.minValue - 1);
+        CHECK(settingsConfig.load().*setting.field == (setting.isClamped ? setting.minValue : setting.defaultValue));
+
+        settingsConfig.user.setValue(kConfigSectionMain, setting.key, setting.maxValue + 1);
+        CHECK(settingsConfig.load().*setting.field == (setting.isClamped ? setting.maxValue : setting.defaultValue));
+
+        // Not a number is missing.
+        settingsConfig.user.setValue(kConfigSectionMain, setting.key, L"fast");
+        CHECK(settingsConfig.load().*setting.field == setting.defaultValue);
+    }
+}
+
+
+TEST_CASE(boolAndStringValuesAreRead)
+{
+    SettingsConfig settingsConfig;
+    settingsConfig.user.setValue(kConfigSectionMain, kConfigKeyEnableRunAfterburner, 0);
+    settingsConfig.user.setValue(kConfigSectionMain, kConfigKeyLanguage, L" ru ");
+    settingsConfig.user.setValue(L"2", kConfigKeyProfileName, L"Games");
+    settingsConfig.user.setValue(L"2", kConfigKeyProfileEnabled, 1);
+
+    const AfterburnerSettings loaded = settingsConfig.load();
+
+    CHECK(!loaded.isRunAfterburnerMenuEnabled);
+    CHECK(loaded.preferredLanguage == L"ru");
+    CHECK(loaded.profiles[1].name == L"Games");
+    CHECK(loaded.profiles[1].isEnabled);
+    CHECK(!loaded.profiles[0].isEnabled);
+}
+
+
+TEST_MAIN()
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "BenchmarkRunner.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+static std::atomic<uint64_t> allocations(0);
+
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void *memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+
+namespace Loader
+{
+
+namespace Tests
+{
+    uint64_t getAllocations()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+}
+
+}
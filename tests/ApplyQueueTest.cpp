@@ -0,0 +1,119 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../loader/ApplyQueue.h"
+
+
+using namespace Loader;
+
+
+static ApplyRequest makeRequest(const std::wstring &profile, ApplyPriority priority = ApplyPriority::User, bool isForced = false)
+{
+    return ApplyRequest{profile, 1, priority, isForced};
+}
+
+
+TEST_CASE(requestsDuringFlightAreCoalesced)
+{
+    ApplyQueue queue;
+    ApplyRequest next = makeRequest(L"");
+
+    CHECK(queue.push(makeRequest(L"Quiet")));
+    CHECK(!queue.push(makeRequest(L"Games")));
+    CHECK(!queue.push(makeRequest(L"Video")));
+    CHECK(!queue.push(makeRequest(L"Games")));
+
+    // Only the last request runs after the one in flight.
+    CHECK(queue.finish(&next));
+    CHECK(next.profile == L"Games");
+    CHECK(!queue.finish(&next));
+
+    CHECK(queue.getStartedRequests() == 2);
+    CHECK(queue.getSupersededRequests() == 2);
+    CHECK(queue.getSavedSpawns() == 2);
+}
+
+
+TEST_CASE(automaticRequestsGiveWayToUser)
+{
+    ApplyQueue queue;
+    ApplyRequest next = makeRequest(L"");
+
+    CHECK(queue.push(makeRequest(L"Quiet")));
+    CHECK(!queue.push(makeRequest(L"Startup", ApplyPriority::Automatic)));
+    CHECK(queue.getDroppedRequests() == 1);
+    CHECK(!queue.finish(&next));
+
+    // Automatic request in flight is followed by the user one, not by another automatic one.
+    CHECK(queue.push(makeRequest(L"Startup", ApplyPriority::Automatic)));
+    CHECK(!queue.push(makeRequest(L"Games")));
+    CHECK(!queue.push(makeRequest(L"Startup", ApplyPriority::Automatic)));
+    CHECK(queue.finish(&next));
+    CHECK(next.profile == L"Games" && next.priority == ApplyPriority::User);
+    CHECK(queue.getDroppedRequests() == 2);
+    CHECK(queue.getSupersededRequests() == 0);
+}
+
+
+TEST_CASE(confirmedProfileIsSkipped)
+{
+    ApplyQueue queue;
+    int checks = 0;
+    const ApplyQueue::AppliedCheck isApplied = [&checks](const std::wstring &profile)
+    {
+        checks++;
+        return profile == L"Quiet";
+    };
+
+    CHECK(queue.skipIfApplied(makeRequest(L"Quiet"), isApplied));
+    CHECK(!queue.skipIfApplied(makeRequest(L"Games"), isApplied));
+    CHECK(checks == 2);
+
+    // Forced request is started anyway, the check is not even made.
+    CHECK(!queue.skipIfApplied(makeRequest(L"Quiet", ApplyPriority::User, true), isApplied));
+    CHECK(checks == 2);
+
+    CHECK(queue.getSkippedRequests() == 1);
+    CHECK(queue.getSavedSpawns() == 1);
+}
+
+
+TEST_CASE(pendingRequestIsClearedOnCompletion)
+{
+    ApplyQueue queue;
+    ApplyRequest next = makeRequest(L"");
+
+    CHECK(queue.push(makeRequest(L"Quiet")));
+    CHECK(!queue.push(makeRequest(L"Games")));
+    CHECK(queue.finish(&next));
+    CHECK(next.profile == L"Games");
+
+    // Started pending request leaves the slot empty: its completion starts nothing.
+    CHECK(!queue.finish(&next));
+    CHECK(next.profile == L"Games");
+
+    // Idle queue starts the next request right away.
+    CHECK(queue.push(makeRequest(L"Video")));
+    CHECK(!queue.finish(&next));
+    CHECK(queue.getStartedRequests() == 3);
+}
+
+
+TEST_MAIN()
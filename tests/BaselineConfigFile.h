@@ -0,0 +1,197 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __TESTS_BASELINE_CONFIG_FILE_H__
+#define __TESTS_BASELINE_CONFIG_FILE_H__
+
+
+#include <algorithm>
+#include <fstream>
+#include <locale>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace Loader
+{
+
+namespace Tests
+{
+
+// Reference for benchmarks: the original 'ConfigFile' before the storage and parser rework.
+// Map of maps storage, 'std::getline' reading, locale based trimming that builds a locale per character.
+// The original used 'en_US.UTF-8', 'C.UTF-8' is the locale every glibc system has.
+template<typename StringType>
+class BaselineConfigFile
+{
+public:
+    typedef typename StringType::value_type CharType;
+
+    static std::locale getLocale()
+    {
+        if constexpr (std::is_same<CharType, wchar_t>::value)
+        {
+            std::ios::sync_with_stdio(false);
+            return std::locale("C.UTF-8");
+        }
+        else
+        {
+            return std::locale::classic();
+        }
+    }
+
+    static bool isNonSpace(CharType ch)
+    {
+        return !std::isspace<CharType>(ch, getLocale());
+    }
+
+    static StringType& trim(StringType &str)
+    {
+        str.erase(str.begin(), std::find_if(str.begin(), str.end(), isNonSpace));
+        str.erase(std::find_if(str.rbegin(), str.rend(), isNonSpace).base(), str.end());
+
+        return str;
+    }
+
+    static StringType trim(const StringType &str)
+    {
+        StringType strCopy = str;
+        return trim(strCopy);
+    }
+
+    void reload(const std::string &path)
+    {
+        std::basic_ifstream<CharType> file(path, std::ios_base::in);
+
+        if (file.is_open())
+        {
+            file.imbue(getLocale());
+
+            config.clear();
+
+            StringType section;
+            StringType key;
+            StringType value;
+
+            for (StringType line; std::getline(file, line);)
+            {
+                if (parseLine(line, &section, &key, &value))
+                {
+                    config[section][key] = value;
+                }
+            }
+        }
+    }
+
+    std::vector<StringType> listSections() const
+    {
+        std::vector<StringType> sections;
+        sections.reserve(config.size());
+
+        for (const auto &it : config)
+        {
+            sections.push_back(it.first);
+        }
+
+        return sections;
+    }
+
+    std::vector<StringType> listKeys(const StringType &section) const
+    {
+        std::vector<StringType> keys;
+
+        const auto sectionIt = config.find(section);
+        if (sectionIt != config.end())
+        {
+            for (const auto &it : sectionIt->second)
+            {
+                keys.push_back(it.first);
+            }
+        }
+
+        return keys;
+    }
+
+    const StringType& getValue(const StringType &section, const StringType &key) const
+    {
+        static const StringType kEmptyString;
+        const StringType *valuePtr = &kEmptyString;
+
+        const auto sectionIt = config.find(trim(section));
+        if (sectionIt != config.end())
+        {
+            const auto keyIt = sectionIt->second.find(trim(key));
+            if (keyIt != sectionIt->second.end())
+            {
+                valuePtr = &keyIt->second;
+            }
+        }
+
+        return *valuePtr;
+    }
+
+    void setValue(const StringType &section, const StringType &key, const StringType &value)
+    {
+        trim(config[trim(section)][trim(key)]) = trim(value);
+    }
+
+private:
+    bool parseLine(const StringType &line, StringType *inOutSection, StringType *outKey, StringType *outValue) const
+    {
+        bool isParsed = false;
+
+        StringType trimmedLine = trim(line);
+
+        if (trimmedLine.size() > 2)
+        {
+            if (trimmedLine.front() == '[' && trimmedLine.back() == ']')
+            {
+                *inOutSection = trim(trimmedLine.substr(1, trimmedLine.size() - 2));
+            }
+            else
+            {
+                const size_t delimPos = trimmedLine.find('=');
+                if (delimPos != StringType::npos)
+                {
+                    *outKey = trim(trimmedLine.substr(0, delimPos));
+                    *outValue = trim(trimmedLine.substr(delimPos + 1));
+
+                    isParsed = !outKey->empty();
+                }
+            }
+        }
+
+        return isParsed;
+    }
+
+private:
+    std::map<StringType, std::map<StringType, StringType>> config;
+};
+
+}
+
+}
+
+
+#endif
+
+
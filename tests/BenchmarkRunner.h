@@ -0,0 +1,108 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __TESTS_BENCHMARK_RUNNER_H__
+#define __TESTS_BENCHMARK_RUNNER_H__
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+
+namespace Loader
+{
+
+namespace Tests
+{
+    // Number of 'operator new' calls since start, counted by 'AllocationCounter.cpp'.
+    uint64_t getAllocations();
+
+    struct Measurement
+    {
+        double microseconds; // Per iteration.
+        double allocations;  // Per iteration.
+    };
+
+    // Runs 'function' up to 'iterations' times, stops earlier when the time budget is spent.
+    template<typename Function>
+    Measurement measure(size_t iterations, Function &&function, double maxMilliseconds = 2000.0)
+    {
+        function(); // Warm up.
+
+        const uint64_t allocationsBefore = getAllocations();
+        const auto startTime = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        size_t done = 0;
+
+        while (done < iterations && elapsed < maxMilliseconds * 1000.0)
+        {
+            function();
+            done++;
+            elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+        }
+
+        return Measurement{elapsed / (double)done, (double)(getAllocations() - allocationsBefore) / (double)done};
+    }
+
+    // Benchmarks run by ctest get '--quick': small inputs and few iterations, only to keep them working.
+    inline bool isQuickRun(int argc, char **argv)
+    {
+        bool isQuick = false;
+
+        for (int i = 1; i < argc && !isQuick; ++i)
+        {
+            isQuick = strcmp(argv[i], "--quick") == 0;
+        }
+
+        return isQuick;
+    }
+
+    inline void printMeasurement(const char *name, const std::string &input, const Measurement &measurement)
+    {
+        printf("%-28s %-14s %12.2f us %12.1f allocs\n", name, input.c_str(), measurement.microseconds, measurement.allocations);
+    }
+
+    inline void printComparison(const char *name, const std::string &input, const Measurement &baseline, const Measurement &current)
+    {
+        printf("%-28s %-14s baseline %10.2f us %9.1f allocs | current %10.2f us %9.1f allocs | x%.1f\n",
+            name, input.c_str(), baseline.microseconds, baseline.allocations, current.microseconds, current.allocations,
+            current.microseconds > 0.0 ? baseline.microseconds / current.microseconds : 0.0);
+    }
+
+    inline std::string formatSize(size_t size)
+    {
+        return size >= 1024 * 1024
+            ? std::to_string(size / (1024 * 1024)) + " MB"
+            : size >= 1024
+                ? std::to_string(size / 1024) + " KB"
+                : std::to_string(size) + " B";
+    }
+}
+
+}
+
+
+#endif
+
+
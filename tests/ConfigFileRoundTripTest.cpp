@@ -0,0 +1,230 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Format preserving saves over a corpus of hand written configs. Every config has the value 'OLDVALUE'
+// of 'Profile1/Name' exactly once. Each one is checked in every encoding, string type and load mode.
+
+
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+#include "../utils/TextEncoding.h"
+
+
+using namespace Loader;
+using namespace std::literals;
+
+
+struct CorpusEntry
+{
+    const char *name;
+    const char *text; // UTF-8.
+};
+
+
+static const CorpusEntry kCorpus[] =
+{
+    {"plain", "[Main]\r\nStartupProfile=1\r\n[Profile1]\r\nName=OLDVALUE\r\nEnabled=1\r\n"},
+    {"comments and blank lines",
+        "; header\r\n\r\n[Main]\r\n; comment\r\nStartupDelay = 10\r\n\r\n[Profile1]\r\n  Name  =  OLDVALUE  \r\n"
+        "# other comment\r\nEnabled=1\r\n\r\n; trailer\r\n"},
+    {"lf line breaks", "[Main]\nStartupProfile=1\n\n[Profile1]\nName=OLDVALUE\nEnabled=0\n"},
+    {"mixed line breaks", "[Main]\r\nStartupProfile=1\n[Profile1]\r\nName=OLDVALUE\nEnabled=0\r\n"},
+    {"no final line break", "[Main]\r\nStartupProfile=1\r\n[Profile1]\r\nEnabled=1\r\nName=OLDVALUE"},
+    {"unparsed lines", "garbage line\r\n[Profile1]\r\nName=OLDVALUE\r\n=no key\r\n[]\r\nx\r\n"},
+    {"duplicated keys", "[Profile1]\r\nName=first\r\nName=OLDVALUE\r\nEnabled=1\r\n"},
+    {"unicode", "[Profile1]\r\nName=OLDVALUE\r\nComment=\xD0\x9F\xD1\x80\xD0\xBE\xD1\x84\xD0\xB8\xD0\xBB\xD1\x8C \xE2\x9C\x93\r\n"},
+    {"keys before sections", "Top=1\r\n[Profile1]\r\nName=OLDVALUE\r\n"},
+    {"repeated section", "[Profile1]\r\nEnabled=1\r\n[Main]\r\nStartupProfile=1\r\n[Profile1]\r\nName=OLDVALUE\r\n"},
+    {"spaces in section header", "[ Profile1 ]\r\nName=OLDVALUE\r\n[Main]\r\n"},
+    {"tabs", "[Profile1]\t\r\n\tName\t=\tOLDVALUE\t\r\n\tEnabled\t=\t1\r\n"}
+};
+
+static const TextEncoding::Encoding kEncodings[] =
+{
+    TextEncoding::Encoding::Utf8,
+    TextEncoding::Encoding::Utf8Bom,
+    TextEncoding::Encoding::Utf16LE,
+    TextEncoding::Encoding::Utf16BE
+};
+
+static const ConfigLoadMode kLoadModes[] = {ConfigLoadMode::Eager, ConfigLoadMode::Lazy};
+
+
+static std::string encode(const std::string &text, TextEncoding::Encoding encoding)
+{
+    std::string bytes;
+    TextEncoding::encode(text, encoding, &bytes);
+    return bytes;
+}
+
+
+static std::string replaceOnce(std::string text, const std::string &from, const std::string &to)
+{
+    const size_t pos = text.find(from);
+    return pos != std::string::npos ? text.replace(pos, from.size(), to) : text;
+}
+
+
+template<typename StringType>
+static StringType toStringType(std::string_view text)
+{
+    return StringType(text.begin(), text.end()); // ASCII only.
+}
+
+
+template<typename StringType>
+static void checkCorpus()
+{
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+
+    const StringType section = toStringType<StringType>("Profile1");
+    const StringType name = toStringType<StringType>("Name");
+
+    for (const auto &entry : kCorpus)
+    {
+        for (const auto encoding : kEncodings)
+        {
+            for (const auto loadMode : kLoadModes)
+            {
+                Tests::TempDir dir;
+                const std::string path = dir.getFilePath("a.cfg");
+                const std::string original = encode(entry.text, encoding);
+
+                // Value changed and changed back: text is patched to exactly the same bytes.
+                Tests::writeFile(path, original);
+                {
+                    ConfigFile<StringType> config(dir.getWideFilePath("a.cfg"), loadMode);
+                    config.setValue(StringViewType(section), StringViewType(name), StringViewType(toStringType<StringType>("temp")));
+                    config.setValue(StringViewType(section), StringViewType(name), StringViewType(toStringType<StringType>("OLDVALUE")));
+                    CHECK(config.save());
+                }
+
+                const bool isUnchanged = Tests::readFile(path) == original;
+                CHECK(isUnchanged);
+
+                // Only the bytes of the changed value differ.
+                {
+                    ConfigFile<StringType> config(dir.getWideFilePath("a.cfg"), loadMode);
+                    config.setValue(StringViewType(section), StringViewType(name), StringViewType(toStringType<StringType>("NEW VALUE")));
+                    CHECK(config.save());
+                }
+
+                const bool isPatched = Tests::readFile(path) == encode(replaceOnce(entry.text, "OLDVALUE", "NEW VALUE"), encoding);
+                CHECK(isPatched);
+
+                // New key is one more line of the section, new section is appended.
+                Tests::writeFile(path, original);
+                {
+                    ConfigFile<StringType> config(dir.getWideFilePath("a.cfg"), loadMode);
+                    config.setValue(StringViewType(section), StringViewType(toStringType<StringType>("Added")), 7);
+                    config.setValue(StringViewType(toStringType<StringType>("NewSection")), StringViewType(toStringType<StringType>("Key")), 8);
+                    CHECK(config.save());
+                }
+
+                std::string saved;
+                TextEncoding::decode(Tests::readFile(path).data(), Tests::readFile(path).size(), encoding, &saved);
+                if (encoding != TextEncoding::Encoding::Utf8)
+                {
+                    saved.erase(0, saved.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0);
+                }
+
+                const std::string newSection = "[NewSection]\r\nKey=8\r\n";
+                const bool hasNewSection = saved.size() >= newSection.size() &&
+                    saved.compare(saved.size() - newSection.size(), newSection.size(), newSection) == 0;
+                CHECK(hasNewSection);
+
+                std::string withoutAdded = replaceOnce(saved.substr(0, saved.size() - newSection.size()), "Added=7\r\n", "");
+                const std::string text = entry.text;
+                const bool isOnlyAdded = withoutAdded == text || withoutAdded == text + "\r\n";
+                CHECK(isOnlyAdded);
+
+                {
+                    ConfigFile<StringType> config(dir.getWideFilePath("a.cfg"), loadMode);
+                    CHECK(config.getValue(StringViewType(section), StringViewType(toStringType<StringType>("Added")), 0) == 7);
+                    CHECK(config.getValue(StringViewType(section), StringViewType(name)) == toStringType<StringType>("OLDVALUE"));
+                }
+
+                if (!isUnchanged || !isPatched || !hasNewSection || !isOnlyAdded)
+                {
+                    fprintf(stderr, "  corpus entry '%s', encoding %d, load mode %d\n", entry.name, (int)encoding, (int)loadMode);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_CASE(roundTripOfNarrowConfigs)
+{
+    checkCorpus<std::string>();
+}
+
+
+TEST_CASE(roundTripOfWideConfigs)
+{
+    checkCorpus<std::wstring>();
+}
+
+
+TEST_CASE(repeatedSavesPatchShiftedValues)
+{
+    Tests::TempDir dir;
+    std::string expected = "; c\r\n[a]\r\nx=1\r\ny = 2\r\n\r\n[b]\r\nz=3\r\n";
+    Tests::writeFile(dir.getFilePath("a.cfg"), expected);
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    const char *values[] = {"longer value", "", "4", "even longer value"};
+
+    for (const char *value : values)
+    {
+        // Positions of the values after the changed one move with every save.
+        expected = replaceOnce(expected, "x=" + config.getValue("a"sv, "x"sv) + "\r\n", "x=" + std::string(value) + "\r\n");
+        expected = replaceOnce(expected, "z=" + config.getValue("b"sv, "z"sv) + "\r\n", "z=" + std::string(value) + "z\r\n");
+        config.setValue("a"sv, "x"sv, std::string_view(value));
+        config.setValue("b"sv, "z"sv, std::string(value) + "z");
+        CHECK(config.save());
+        CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == expected);
+    }
+
+    config.setValue("a"sv, "w"sv, "5"sv);
+    config.setValue("b"sv, "z"sv, "6"sv);
+    CHECK(config.save());
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "; c\r\n[a]\r\nx=even longer value\r\ny = 2\r\nw=5\r\n\r\n[b]\r\nz=6\r\n");
+}
+
+
+TEST_CASE(rebuildModeDropsLayout)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "; comment\r\n[b]\r\nk=1\r\n\r\n[a]\r\n z = 2 \r\n");
+
+    {
+        ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+        config.setLayoutMode(ConfigLayoutMode::Rebuild);
+        config.setValue("a"sv, "y"sv, "3"sv);
+        CHECK(config.save());
+    }
+
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "[a]\r\ny=3\r\nz=2\r\n[b]\r\nk=1\r\n");
+}
+
+
+TEST_MAIN()
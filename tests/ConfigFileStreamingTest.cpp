@@ -0,0 +1,197 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Streaming parser: files are decoded and parsed by blocks of 64 KB, lines cross block boundaries.
+
+
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+
+
+using namespace Loader;
+using namespace std::literals;
+
+
+static const TextEncoding::Encoding kEncodings[] =
+{
+    TextEncoding::Encoding::Utf8,
+    TextEncoding::Encoding::Utf8Bom,
+    TextEncoding::Encoding::Utf16LE,
+    TextEncoding::Encoding::Utf16BE
+};
+
+
+static std::string getKey(size_t index)
+{
+    return "Key" + std::to_string(index);
+}
+
+
+// Multibyte characters and surrogate pairs in every value, so some of them fall on block boundaries.
+static std::string getValue(size_t index)
+{
+    return "\xD0\x97\xD0\xBD\xD0\xB0\xD1\x87\xD0\xB5\xD0\xBD\xD0\xB8\xD0\xB5 \xE2\x9C\x93 \xF0\x9F\x98\x80 " +
+        std::to_string(index) + std::string(index % 37, '.');
+}
+
+
+// About 'targetSize' bytes of UTF-8 text, first line is 'shift' characters longer to move the boundaries.
+static std::string generateText(size_t targetSize, size_t shift, size_t *outKeysCount)
+{
+    std::string text = "; " + std::string(shift, 'x') + "\r\n";
+    size_t keysCount = 0;
+
+    while (text.size() < targetSize)
+    {
+        if (keysCount % 100 == 0)
+        {
+            text += "[Section" + std::to_string(keysCount / 100) + "]\n";
+        }
+
+        text += getKey(keysCount) + " = " + getValue(keysCount) + (keysCount % 2 ? "\r\n" : "\n");
+        keysCount++;
+    }
+
+    *outKeysCount = keysCount;
+
+    return text;
+}
+
+
+template<typename StringType>
+static StringType toStringType(const std::string &text)
+{
+    StringType result;
+    TextEncoding::decode(text.data(), text.size(), TextEncoding::Encoding::Utf8, &result);
+    return result;
+}
+
+
+template<typename StringType>
+static bool hasAllKeys(const ConfigFile<StringType> &config, size_t keysCount)
+{
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+
+    bool isLoaded = true;
+
+    for (size_t i = 0; i < keysCount && isLoaded; ++i)
+    {
+        const StringType section = toStringType<StringType>("Section" + std::to_string(i / 100));
+        const StringType key = toStringType<StringType>(getKey(i));
+        const StringType *value = config.findValue(StringViewType(section), StringViewType(key));
+
+        isLoaded = value != nullptr && *value == toStringType<StringType>(getValue(i));
+        if (!isLoaded)
+        {
+            fprintf(stderr, "  key %zu is not loaded\n", i);
+        }
+    }
+
+    return isLoaded;
+}
+
+
+template<typename StringType>
+static void checkBlockBoundaries()
+{
+    for (const auto encoding : kEncodings)
+    {
+        // Shifts move every boundary through all bytes of UTF-8 sequences and both bytes of UTF-16 units.
+        for (size_t shift = 0; shift < 6; ++shift)
+        {
+            size_t keysCount = 0;
+            const std::string text = generateText(200 * 1024, shift, &keysCount);
+            std::string bytes;
+            TextEncoding::encode(text, encoding, &bytes);
+
+            Tests::TempDir dir;
+            Tests::writeFile(dir.getFilePath("a.cfg"), bytes);
+
+            const ConfigFile<StringType> config(dir.getWideFilePath("a.cfg"));
+            const bool isLoaded = hasAllKeys(config, keysCount);
+            CHECK(isLoaded);
+
+            if (!isLoaded)
+            {
+                fprintf(stderr, "  encoding %d, shift %zu\n", (int)encoding, shift);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(narrowLinesCrossBlockBoundaries)
+{
+    checkBlockBoundaries<std::string>();
+}
+
+
+TEST_CASE(wideLinesCrossBlockBoundaries)
+{
+    checkBlockBoundaries<std::wstring>();
+}
+
+
+TEST_CASE(lineLongerThanBlock)
+{
+    const std::string longValue(150 * 1024, 'v');
+
+    for (const auto encoding : kEncodings)
+    {
+        std::string bytes;
+        TextEncoding::encode("[a]\r\nfirst=1\r\nlong=" + longValue + "\r\nlast=2\r\n[b]\r\nk=3", encoding, &bytes);
+
+        Tests::TempDir dir;
+        Tests::writeFile(dir.getFilePath("a.cfg"), bytes);
+
+        const ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+        CHECK(config.getValue("a"sv, "first"sv) == "1");
+        CHECK(config.getValue("a"sv, "long"sv) == longValue);
+        CHECK(config.getValue("a"sv, "last"sv) == "2");
+        CHECK(config.getValue("b"sv, "k"sv) == "3");
+    }
+}
+
+
+TEST_CASE(largeFileIsLoadedAndSaved)
+{
+    // Bigger than the old 256 KB limit and than the retained text, such file is rebuilt on save.
+    size_t keysCount = 0;
+    const std::string text = generateText(3 * 1024 * 1024, 0, &keysCount);
+
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), text);
+
+    {
+        ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+        CHECK(hasAllKeys(config, keysCount));
+
+        config.setValue("Section0"sv, "Added"sv, "new"sv);
+        CHECK(config.save());
+    }
+
+    const ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    CHECK(hasAllKeys(config, keysCount));
+    CHECK(config.getValue("Section0"sv, "Added"sv) == "new");
+}
+
+
+TEST_MAIN()
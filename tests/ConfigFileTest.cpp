@@ -0,0 +1,305 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+using namespace Loader;
+using namespace std::literals;
+
+
+static const char kParsedConfig[] =
+    "TopKey=top\n"
+    "[1]\r\n"
+    "Enabled=1\n"
+    " Name = Profile 1 \t\n"
+    "[ 2 ]\n"
+    "Name=x=y\n"
+    "bad line\n"
+    "=no key\n"
+    "[Main]\n"
+    "StartupDelay=5\n"
+    "StartupDelay=7\n"
+    "Last=no line break";
+
+
+TEST_CASE(parsesSectionsKeysAndValues)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), kParsedConfig);
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+
+    CHECK(config.getValue(""sv, "TopKey"sv) == "top");
+    CHECK(config.getValue("1"sv, "Enabled"sv) == "1");
+    CHECK(config.getValue("1"sv, "Name"sv) == "Profile 1");
+    CHECK(config.getValue(" 2 "sv, " Name "sv) == "x=y");
+    CHECK(config.findValue("2"sv, "bad line"sv) == nullptr);
+    CHECK(config.getValue("Main"sv, "StartupDelay"sv, 0) == 7); // Last duplicate wins.
+    CHECK(config.getValue("Main"sv, "Last"sv) == "no line break");
+    CHECK(config.getValue("Main"sv, "Missing"sv, std::string("def")) == "def");
+
+    const std::vector<std::string> sections = config.listSections();
+    CHECK((sections == std::vector<std::string>{"", "1", "2", "Main"}));
+    CHECK((config.listKeys("1") == std::vector<std::string>{"Enabled", "Name"}));
+}
+
+
+TEST_CASE(parsesWideConfigFromUtf8)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), std::string(kParsedConfig) + "\n[\xD0\x9F\xD1\x80\xD0\xBE]\nName=\xD0\x98\xD0\xBC\xD1\x8F\n");
+
+    ConfigFile<std::wstring> config(dir.getWideFilePath("a.cfg"));
+
+    CHECK(config.getValue(L"1"sv, L"Name"sv) == L"Profile 1");
+    CHECK(config.getValue(L"Main"sv, L"StartupDelay"sv, 0) == 7);
+    CHECK(config.getValue(L"Про"sv, L"Name"sv) == L"Имя");
+}
+
+
+TEST_CASE(valuesSurviveSaveAndReload)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+
+    {
+        ConfigFile<std::wstring> config(path);
+        config.setValue(L"Main"sv, L"StartupProfile"sv, 3);
+        config.setValue(L" Profile1 "sv, L" Name "sv, L" First "sv);
+        CHECK(config.save());
+        CHECK(!config.hasUnsavedChanges());
+    }
+
+    ConfigFile<std::wstring> config(path);
+    CHECK(config.getValue(L"Main"sv, L"StartupProfile"sv, 0) == 3);
+    CHECK(config.getValue(L"Profile1"sv, L"Name"sv) == L"First");
+}
+
+
+TEST_CASE(acceptsLiteralsPointersAndStrings)
+{
+    Tests::TempDir dir;
+
+    ConfigFile<std::wstring> wideConfig(dir.getWideFilePath("a.cfg"));
+    wideConfig.setValue(L"Settings", L"Key", L"value");
+    wideConfig.setValue(L"Settings", L"Number", 5);
+    CHECK(wideConfig.getValue(L"Settings", L"Key") == L"value");
+    CHECK(wideConfig.getValue(L"Settings", L"Number", 0) == 5);
+    CHECK(wideConfig.getValue(L"Settings", L"Missing", L"default") == L"default");
+    CHECK(wideConfig.findValue(L"Settings", L"Key") != nullptr);
+    CHECK(wideConfig.listKeys(L"Settings").size() == 2);
+    wideConfig.clearValue(L"Settings", L"Key");
+    CHECK(wideConfig.getValue(L"Settings", L"Key").empty());
+
+    const char *section = "a";
+    const std::string key = "b";
+    ConfigFile<std::string> config(dir.getWideFilePath("b.cfg"));
+    config.setValue("a", "b", "c");
+    CHECK(config.getValue(section, key) == "c");
+    CHECK(config.getValue(std::string(section), "b", std::string("d")) == "c");
+    config.setValue(section, key, key);
+    CHECK(config.getValue("a", "b") == "b");
+}
+
+
+TEST_CASE(externalEditOfOtherKeyIsMerged)
+{
+    Tests::TempDir dir;
+    const std::string path = dir.getFilePath("a.cfg");
+    Tests::writeFile(path, "[Main]\nA=1\nB=1\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    config.setValue("Main", "A", "2");
+
+    Tests::writeFile(path, "[Main]\nA=1\nB=22\n");
+    CHECK(config.save());
+    CHECK(Tests::readFile(path) == "[Main]\nA=2\nB=22\n");
+    CHECK(config.getValue("Main", "B") == "22");
+    CHECK(config.getMergedSaves() == 1);
+    CHECK(config.getMergeConflicts() == 0);
+}
+
+
+TEST_CASE(localValueWinsConflict)
+{
+    Tests::TempDir dir;
+    const std::string path = dir.getFilePath("a.cfg");
+    Tests::writeFile(path, "[Main]\nA=1\nB=1\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    config.setValue("Main", "A", "2");
+
+    Tests::writeFile(path, "[Main]\nA=333\nB=1\n");
+    CHECK(config.save());
+    CHECK(Tests::readFile(path) == "[Main]\nA=2\nB=1\n");
+    CHECK(config.getMergedSaves() == 1);
+    CHECK(config.getMergeConflicts() == 1);
+
+    // Same value on both sides is not a conflict.
+    config.setValue("Main", "B", "5");
+    Tests::writeFile(path, "[Main]\nA=2\nB=5\n\n");
+    CHECK(config.save());
+    CHECK(config.getMergedSaves() == 2);
+    CHECK(config.getMergeConflicts() == 1);
+}
+
+
+TEST_CASE(externalDeleteOfUntouchedKeyIsKept)
+{
+    Tests::TempDir dir;
+    const std::string path = dir.getFilePath("a.cfg");
+    Tests::writeFile(path, "[Main]\nA=1\nB=1\n[Other]\nC=1\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    config.setValue("Main", "A", "2");
+
+    Tests::writeFile(path, "[Main]\nA=1\n");
+    CHECK(config.save());
+    CHECK(config.findValue("Main", "B") == nullptr);
+    CHECK(config.findValue("Other", "C") == nullptr);
+
+    const ConfigFile<std::string> saved(dir.getWideFilePath("a.cfg"));
+    CHECK(saved.getValue("Main", "A") == "2");
+    CHECK(saved.findValue("Main", "B") == nullptr);
+    CHECK(saved.findValue("Other", "C") == nullptr);
+}
+
+
+TEST_CASE(lazySectionIsParsedOnFirstAccess)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[A]\nk=a\n[B]\nk=b\n[C]\nk=c\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"), ConfigLoadMode::Lazy);
+    CHECK(config.getLazyParsedSections() == 0);
+
+    CHECK(config.getValue("B"sv, "k"sv) == "b");
+    CHECK(config.getValue("B"sv, "k"sv) == "b");
+    CHECK(config.findValue("Missing"sv, "k"sv) == nullptr);
+    CHECK(config.getLazyParsedSections() == 1);
+
+    CHECK(config.listSections().size() == 3);
+    CHECK(config.getLazyParsedSections() == 3);
+
+    CHECK(config.reload());
+    CHECK(config.getLazyParsedSections() == 0);
+}
+
+
+TEST_CASE(lazyPatchSaveKeepsOtherSectionsUnparsed)
+{
+    Tests::TempDir dir;
+    const std::string path = dir.getFilePath("a.cfg");
+    Tests::writeFile(path, "[A]\nk=a\n[B]\nk=b\n[C]\nk=c1\n[D]\nk=d\n[C]\nj=c2\n[E]\nk=e\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"), ConfigLoadMode::Lazy);
+
+    // Changed value moves the text of the sections after it.
+    config.setValue("B"sv, "k"sv, "bbbb"sv);
+    CHECK(config.save());
+    CHECK(config.getLazyParsedSections() == 1);
+    CHECK(config.getValue("D"sv, "k"sv) == "d");
+    CHECK(config.getLazyParsedSections() == 2);
+
+    // New key makes the layout indexed again.
+    config.setValue("D"sv, "new"sv, "x"sv);
+    CHECK(config.save());
+    CHECK(config.getLazyParsedSections() == 2);
+    CHECK(config.getValue("C"sv, "k"sv) == "c1");
+    CHECK(config.getValue("C"sv, "j"sv) == "c2");
+    CHECK(config.getLazyParsedSections() == 3);
+
+    config.setValue("C"sv, "j"sv, "2"sv);
+    CHECK(config.save());
+    CHECK(config.getValue("E"sv, "k"sv) == "e");
+    config.setValue("E"sv, "k"sv, "eee"sv);
+    CHECK(config.save());
+    CHECK(config.getLazyParsedSections() == 4);
+
+    CHECK(Tests::readFile(path) == "[A]\nk=a\n[B]\nk=bbbb\n[C]\nk=c1\n[D]\nk=d\nnew=x\r\n[C]\nj=2\n[E]\nk=eee\n");
+    CHECK(config.getValue("A"sv, "k"sv) == "a");
+}
+
+
+TEST_CASE(missingFileIsEmptyConfig)
+{
+    Tests::TempDir dir;
+    ConfigFile<std::string> config(dir.getWideFilePath("missing.cfg"));
+
+    CHECK(config.listSections().empty());
+    CHECK(config.getValue("Main"sv, "Key"sv).empty());
+    CHECK(config.save()); // Nothing to save.
+    CHECK(!FileSystem::isFileExist(dir.getWideFilePath("missing.cfg")));
+}
+
+
+TEST_CASE(emptyFileClearsLoadedValues)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[Main]\nKey=1\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    CHECK(config.getValue("Main"sv, "Key"sv) == "1");
+
+    Tests::writeFile(dir.getFilePath("a.cfg"), "");
+    CHECK(config.reload());
+    CHECK(config.findValue("Main"sv, "Key"sv) == nullptr);
+    CHECK(config.getFileInfo().size == 0);
+}
+
+
+TEST_CASE(unreadableFileKeepsLoadedValues)
+{
+    Tests::TempDir dir;
+    const std::string path = dir.getFilePath("a.cfg");
+    Tests::writeFile(path, "[Main]\nKey=1\n");
+
+    ConfigFile<std::string> config(dir.getWideFilePath("a.cfg"));
+    const FileSystem::FileInfo loadedInfo = config.getFileInfo();
+
+    // Stands for a file locked by its writer, permissions do not apply to root.
+    Tests::writeFile(path, "[Main]\nKey=2\nOther=3\n");
+    CHECK(chmod(path.c_str(), 0) == 0);
+
+    if (geteuid() != 0)
+    {
+        CHECK(!config.reload());
+        CHECK(config.getValue("Main"sv, "Key"sv) == "1");
+        CHECK(config.getFileInfo().size == loadedInfo.size);
+    }
+    else
+    {
+        fprintf(stderr, "  running as root, unreadable file check is skipped\n");
+    }
+
+    // Next change notification loads the file once it is readable.
+    CHECK(chmod(path.c_str(), 0644) == 0);
+    CHECK(config.reload());
+    CHECK(config.getValue("Main"sv, "Key"sv) == "2");
+    CHECK(config.getValue("Main"sv, "Other"sv) == "3");
+}
+
+
+TEST_MAIN()
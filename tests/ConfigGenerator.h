@@ -0,0 +1,62 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __TESTS_CONFIG_GENERATOR_H__
+#define __TESTS_CONFIG_GENERATOR_H__
+
+
+#include <string>
+
+
+namespace Loader
+{
+
+namespace Tests
+{
+    // Synthetic config of about 'targetSize' bytes: '[Main]' followed by profile like sections,
+    // every section has 'keysPerSection' keys, some comments and blank lines.
+    inline std::string generateConfig(size_t targetSize, size_t keysPerSection)
+    {
+        std::string text = "; Generated config\r\n[Main]\r\nStartupProfile=3\r\nStartupDelay=10\r\n\r\n";
+
+        for (size_t section = 1; text.size() < targetSize; ++section)
+        {
+            text += "[Profile" + std::to_string(section) + "]\r\n";
+            text += "; Comment of the section " + std::to_string(section) + "\r\n";
+
+            for (size_t key = 0; key < keysPerSection && text.size() < targetSize; ++key)
+            {
+                text += " Key" + std::to_string(key) + " = Value " + std::to_string(section * 31 + key) + " \r\n";
+            }
+
+            text += "\r\n";
+        }
+
+        return text;
+    }
+}
+
+}
+
+
+#endif
+
+
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Parse time and allocations of 'ConfigFile::reload' against the original getline based parser.
+
+
+#include "BaselineConfigFile.h"
+#include "BenchmarkRunner.h"
+#include "ConfigGenerator.h"
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+
+
+using namespace Loader;
+
+
+template<typename StringType>
+static void compareParsers(const char *name, const Tests::TempDir &dir, size_t size, size_t iterations, double maxMilliseconds)
+{
+    const std::string path = dir.getFilePath("bench.cfg");
+    Tests::writeFile(path, Tests::generateConfig(size, 8));
+
+    Tests::BaselineConfigFile<StringType> baselineConfig;
+    const Tests::Measurement baseline = Tests::measure(iterations, [&]() { baselineConfig.reload(path); }, maxMilliseconds);
+
+    ConfigFile<StringType> config;
+    const std::wstring widePath(path.begin(), path.end());
+    const Tests::Measurement current = Tests::measure(iterations, [&]() { config.reload(widePath); }, maxMilliseconds);
+
+    Tests::printComparison(name, Tests::formatSize(size), baseline, current);
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    // The original parser ignored files of 256 KB and more.
+    const size_t sizes[] = {1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024 - 1};
+    const size_t parsedBytes = isQuick ? 16 * 1024 : 32 * 1024 * 1024;
+    const double maxMilliseconds = isQuick ? 50.0 : 2000.0;
+    Tests::TempDir dir;
+
+    for (const size_t size : sizes)
+    {
+        if (!isQuick || size <= 4 * 1024)
+        {
+            const size_t iterations = parsedBytes / size > 0 ? parsedBytes / size : 1;
+
+            compareParsers<std::string>("reload<string>", dir, size, iterations, maxMilliseconds);
+            compareParsers<std::wstring>("reload<wstring>", dir, size, iterations, maxMilliseconds);
+        }
+    }
+
+    return 0;
+}
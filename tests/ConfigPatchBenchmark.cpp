@@ -0,0 +1,83 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Save after a small edit of a large config: in place patch of the changed value against rebuilding the file.
+
+
+#include "BenchmarkRunner.h"
+#include "ConfigGenerator.h"
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+
+
+using namespace Loader;
+using namespace std::literals;
+
+
+template<typename StringType>
+static Tests::Measurement measureEdits(const std::wstring &path, ConfigLayoutMode layoutMode, size_t iterations)
+{
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+
+    const StringType section(L"Main"sv.begin(), L"Main"sv.end());
+    const StringType key(L"StartupProfile"sv.begin(), L"StartupProfile"sv.end());
+
+    ConfigFile<StringType> config(path);
+    config.setLayoutMode(layoutMode);
+    config.setWriteDurability(FileSystem::WriteDurability::None);
+
+    int32_t profile = 0;
+
+    return Tests::measure(iterations, [&]()
+    {
+        config.setValue(StringViewType(section), StringViewType(key), profile++ % 5 + 1);
+        config.save();
+    });
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    // Text of bigger files is not retained, such files are always rebuilt.
+    const size_t sizes[] = {64 * 1024, 256 * 1024, 1000 * 1024};
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("bench.cfg");
+
+    for (const size_t size : sizes)
+    {
+        if (!isQuick || size <= 64 * 1024)
+        {
+            const size_t iterations = isQuick ? 1 : 200;
+            Tests::writeFile(dir.getFilePath("bench.cfg"), Tests::generateConfig(size, 8));
+
+            const Tests::Measurement rebuild = measureEdits<std::string>(path, ConfigLayoutMode::Rebuild, iterations);
+            const Tests::Measurement patch = measureEdits<std::string>(path, ConfigLayoutMode::Preserve, iterations);
+            Tests::printComparison("edit and save<string>", Tests::formatSize(size), rebuild, patch);
+
+            const Tests::Measurement wideRebuild = measureEdits<std::wstring>(path, ConfigLayoutMode::Rebuild, iterations);
+            const Tests::Measurement widePatch = measureEdits<std::wstring>(path, ConfigLayoutMode::Preserve, iterations);
+            Tests::printComparison("edit and save<wstring>", Tests::formatSize(size), wideRebuild, widePatch);
+        }
+    }
+
+    return 0;
+}
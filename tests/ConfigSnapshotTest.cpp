@@ -0,0 +1,114 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../loader/ConfigSnapshot.h"
+#include "../utils/ConfigFile.h"
+
+
+using namespace Loader;
+
+
+static ConfigSnapshot::FileState getParsedState(const ConfigFile<std::wstring> &config)
+{
+    return ConfigSnapshot::FileState{config.getFileInfo(), config.getContentHash()};
+}
+
+
+static ConfigSnapshot makeSnapshot()
+{
+    ConfigSnapshot snapshot;
+    snapshot.enabledProfiles = {{L"Quiet", 1}, {L"Games", 3}};
+    snapshot.afterburnerExecutablePath = L"/opt/afterburner/MSIAfterburner.exe";
+    snapshot.preferredLanguage = L"ru";
+    snapshot.startupProfileId = 3;
+    snapshot.applyTimeout = 5000;
+    return snapshot;
+}
+
+
+TEST_CASE(snapshotOfParsedFileIsLoaded)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[Main]\nStartupProfile=3\n");
+
+    const ConfigFile<std::wstring> config(path);
+    const ConfigFile<std::wstring> machineConfig(dir.getWideFilePath("missing.cfg"));
+    CHECK(makeSnapshot().save(path, getParsedState(config), getParsedState(machineConfig)));
+
+    ConfigSnapshot snapshot;
+    CHECK(snapshot.load(path, dir.getWideFilePath("missing.cfg")));
+    CHECK(snapshot.enabledProfiles == makeSnapshot().enabledProfiles);
+    CHECK(snapshot.afterburnerExecutablePath == makeSnapshot().afterburnerExecutablePath);
+    CHECK(snapshot.preferredLanguage == L"ru");
+    CHECK(snapshot.startupProfileId == 3);
+    CHECK(snapshot.applyTimeout == 5000);
+}
+
+
+TEST_CASE(fileChangedAfterParseInvalidatesSnapshot)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[Main]\nStartupProfile=3\n");
+
+    const ConfigFile<std::wstring> config(path);
+
+    // Edited between the parse and the snapshot save, settings above describe the old content.
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[Main]\nStartupProfile=1\nOther=1\n");
+    CHECK(makeSnapshot().save(path, getParsedState(config), ConfigSnapshot::FileState{}));
+
+    ConfigSnapshot snapshot;
+    CHECK(!snapshot.load(path, L""));
+}
+
+
+TEST_CASE(machineConfigChangeInvalidatesSnapshot)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+    const std::wstring machinePath = dir.getWideFilePath("machine.cfg");
+    Tests::writeFile(dir.getFilePath("a.cfg"), "[Main]\nStartupProfile=3\n");
+    Tests::writeFile(dir.getFilePath("machine.cfg"), "[Main]\nApplyTimeout=5000\n");
+
+    const ConfigFile<std::wstring> config(path);
+    const ConfigFile<std::wstring> machineConfig(machinePath);
+    CHECK(makeSnapshot().save(path, getParsedState(config), getParsedState(machineConfig)));
+
+    ConfigSnapshot snapshot;
+    CHECK(snapshot.load(path, machinePath));
+
+    Tests::writeFile(dir.getFilePath("machine.cfg"), "[Main]\nApplyTimeout=9000\n");
+    CHECK(!snapshot.load(path, machinePath));
+}
+
+
+TEST_CASE(missingConfigIsNotSnapshotted)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+    const ConfigFile<std::wstring> config(path);
+
+    CHECK(!makeSnapshot().save(path, getParsedState(config), ConfigSnapshot::FileState{}));
+    CHECK(!FileSystem::isFileExist(ConfigSnapshot::getSnapshotPath(path)));
+}
+
+
+TEST_MAIN()
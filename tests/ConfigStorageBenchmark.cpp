@@ -0,0 +1,193 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// 'ConfigStorage' against the original map of maps: bulk load, lookups, inserts and iteration
+// on synthetic configs with hundreds of sections.
+
+
+#include "BenchmarkRunner.h"
+#include "../utils/ConfigStorage.h"
+#include <map>
+#include <random>
+#include <vector>
+
+
+using namespace Loader;
+
+
+typedef std::map<std::string, std::map<std::string, std::string>> MapOfMaps;
+
+struct Entry
+{
+    std::string section;
+    std::string key;
+    std::string value;
+};
+
+
+static std::vector<Entry> generateEntries(size_t sectionsCount, size_t keysPerSection)
+{
+    std::vector<Entry> entries;
+    entries.reserve(sectionsCount * keysPerSection);
+
+    for (size_t section = 0; section < sectionsCount; ++section)
+    {
+        for (size_t key = 0; key < keysPerSection; ++key)
+        {
+            entries.push_back(Entry{"Profile" + std::to_string(section), "Key" + std::to_string(key),
+                "Value " + std::to_string(section * keysPerSection + key)});
+        }
+    }
+
+    return entries;
+}
+
+
+static void runBenchmarks(size_t sectionsCount, size_t keysPerSection, size_t iterations)
+{
+    const std::vector<Entry> entries = generateEntries(sectionsCount, keysPerSection);
+    const std::string input = std::to_string(sectionsCount) + "x" + std::to_string(keysPerSection);
+
+    std::vector<std::pair<std::string_view, std::string_view>> lookups;
+    std::mt19937 random(1);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        const Entry &entry = entries[random() % entries.size()];
+        lookups.emplace_back(entry.section, entry.key);
+    }
+
+    MapOfMaps mapOfMaps;
+    ConfigStorage<std::string> storage;
+
+    const Tests::Measurement mapLoad = Tests::measure(iterations, [&]()
+    {
+        mapOfMaps.clear();
+        for (const auto &entry : entries)
+        {
+            mapOfMaps[entry.section][entry.key] = entry.value;
+        }
+    });
+
+    const Tests::Measurement storageLoad = Tests::measure(iterations, [&]()
+    {
+        storage.clear();
+        for (const auto &entry : entries)
+        {
+            storage.append(entry.section, entry.key, entry.value);
+        }
+        storage.commit();
+    });
+
+    Tests::printComparison("load", input, mapLoad, storageLoad);
+
+    size_t found = 0;
+
+    // The original lookup took 'const std::string&', so callers with views had to build strings.
+    const Tests::Measurement mapLookup = Tests::measure(iterations, [&]()
+    {
+        for (const auto &lookup : lookups)
+        {
+            const auto section = mapOfMaps.find(std::string(lookup.first));
+            if (section != mapOfMaps.end())
+            {
+                found += section->second.count(std::string(lookup.second));
+            }
+        }
+    });
+
+    const Tests::Measurement storageLookup = Tests::measure(iterations, [&]()
+    {
+        for (const auto &lookup : lookups)
+        {
+            found += storage.find(lookup.first, lookup.second) != nullptr ? 1 : 0;
+        }
+    });
+
+    Tests::printComparison("10000 lookups", input, mapLookup, storageLookup);
+
+    const Tests::Measurement mapIteration = Tests::measure(iterations, [&]()
+    {
+        for (const auto &section : mapOfMaps)
+        {
+            for (const auto &key : section.second)
+            {
+                found += key.first.size();
+            }
+        }
+    });
+
+    const Tests::Measurement storageIteration = Tests::measure(iterations, [&]()
+    {
+        for (const auto &section : storage.sections())
+        {
+            for (const auto &key : storage.keys(section))
+            {
+                found += key.size();
+            }
+        }
+    });
+
+    Tests::printComparison("iterate all names", input, mapIteration, storageIteration);
+
+    // Inserts of new keys into a loaded config, like values written from the menu.
+    size_t mapInserts = 0;
+    const Tests::Measurement mapInsert = Tests::measure(iterations, [&]()
+    {
+        const std::string key = "NewKey" + std::to_string(mapInserts++);
+        for (size_t section = 0; section < sectionsCount; section += 10)
+        {
+            mapOfMaps["Profile" + std::to_string(section)][key] = "1";
+        }
+    });
+
+    size_t storageInserts = 0;
+    const Tests::Measurement storageInsert = Tests::measure(iterations, [&]()
+    {
+        const std::string key = "NewKey" + std::to_string(storageInserts++);
+        for (size_t section = 0; section < sectionsCount; section += 10)
+        {
+            storage.insert("Profile" + std::to_string(section), key) = "1";
+        }
+    });
+
+    Tests::printComparison("inserts of new keys", input, mapInsert, storageInsert);
+
+    if (found == 0)
+    {
+        printf("Nothing found\n");
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+
+    runBenchmarks(100, 10, isQuick ? 1 : 200);
+    runBenchmarks(500, 10, isQuick ? 1 : 50);
+
+    if (!isQuick)
+    {
+        runBenchmarks(2000, 20, 10);
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/ConfigStorage.h"
+#include <map>
+#include <random>
+
+
+using namespace Loader;
+
+
+TEST_CASE(insertKeepsSectionsAndKeysSorted)
+{
+    ConfigStorage<std::string> storage;
+    CHECK(storage.empty());
+
+    storage.insert("b", "y") = "1";
+    storage.insert("a", "z") = "2";
+    storage.insert("b", "x") = "3";
+    storage.insert("a", "z") = "4"; // Existing key.
+
+    CHECK(!storage.empty());
+    CHECK((std::vector<std::string>(storage.sections().begin(), storage.sections().end()) == std::vector<std::string>{"a", "b"}));
+    CHECK((std::vector<std::string>(storage.keys("b").begin(), storage.keys("b").end()) == std::vector<std::string>{"x", "y"}));
+    CHECK(*storage.find("a", "z") == "4");
+    CHECK(storage.find("a", "y") == nullptr);
+    CHECK(storage.find("c", "x") == nullptr);
+    CHECK(storage.keys("c").empty());
+}
+
+
+TEST_CASE(appendedValuesAreCommittedLastWins)
+{
+    ConfigStorage<std::wstring> storage;
+    storage.insert(L"Main", L"Delay") = L"1";
+
+    std::wstring &overridden = storage.append(L"Main", L"Profile", L"old");
+    storage.append(L"Profile1", L"Name", L"First");
+    storage.append(L"Main", L"Profile", L"new");
+    storage.commit();
+
+    CHECK(overridden == L"old"); // Reference stays valid.
+    CHECK(*storage.find(L"Main", L"Profile") == L"new");
+    CHECK(*storage.find(L"Main", L"Delay") == L"1");
+    CHECK(*storage.find(L"Profile1", L"Name") == L"First");
+    CHECK(storage.keys(L"Main").size() == 2);
+
+    storage.clear();
+    CHECK(storage.empty());
+    CHECK(storage.find(L"Main", L"Delay") == nullptr);
+}
+
+
+// Random inserts and appends against a map of maps.
+TEST_CASE(matchesMapOfMaps)
+{
+    std::mt19937 random(7);
+    ConfigStorage<std::string> storage;
+    std::map<std::string, std::map<std::string, std::string>> reference;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const std::string section = "S" + std::to_string(random() % 50);
+        const std::string key = "K" + std::to_string(random() % 30);
+        const std::string value = std::to_string(i);
+
+        if (random() % 3 == 0)
+        {
+            storage.append(section, key, value);
+        }
+        else
+        {
+            storage.insert(section, key) = value;
+        }
+
+        reference[section][key] = value;
+    }
+
+    storage.commit();
+
+    size_t sectionsCount = 0;
+    for (const auto &section : storage.sections())
+    {
+        const auto &referenceKeys = reference[section];
+        CHECK(storage.keys(section).size() == referenceKeys.size());
+
+        auto referenceKey = referenceKeys.begin();
+        for (const auto &key : storage.keys(section))
+        {
+            CHECK(key == referenceKey->first);
+            CHECK(*storage.find(section, key) == referenceKey->second);
+            ++referenceKey;
+        }
+
+        sectionsCount++;
+    }
+
+    CHECK(sectionsCount == reference.size());
+}
+
+
+TEST_MAIN()
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Load of big configs by the streaming parser: throughput and peak memory, up to 100 MB.
+// Every load runs in a child process, so its peak resident size is not mixed with the others.
+
+
+#include "BenchmarkRunner.h"
+#include "ConfigGenerator.h"
+#include "TestRunner.h"
+#include "../utils/ConfigFile.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+using namespace Loader;
+
+
+struct LoadResult
+{
+    double seconds;
+    size_t sectionsCount;
+};
+
+
+template<typename StringType>
+static void printLoad(const char *name, const std::wstring &path, size_t size)
+{
+    int fds[2] = {-1, -1};
+    CHECK(pipe(fds) == 0);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        const ConfigFile<StringType> config(path);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        const LoadResult result = {seconds, config.listSections().size()};
+        const bool isWritten = write(fds[1], &result, sizeof(result)) == (ssize_t)sizeof(result);
+        _exit(isWritten ? 0 : 1);
+    }
+
+    close(fds[1]);
+
+    LoadResult result = {0.0, 0};
+    const bool isRead = read(fds[0], &result, sizeof(result)) == (ssize_t)sizeof(result);
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage = {};
+    CHECK(wait4(pid, &status, 0, &usage) == pid);
+    CHECK(isRead && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    CHECK(result.sectionsCount > 1);
+
+    // Peak includes the mapped file pages that were read and the loaded values.
+    printf("%-28s %-14s %10.1f MB/s %10.1f MB peak RSS %10zu sections\n", name, Tests::formatSize(size).c_str(),
+        (double)size / (1024.0 * 1024.0) / result.seconds, (double)usage.ru_maxrss / 1024.0, result.sectionsCount);
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    const size_t sizes[] = {1024 * 1024, 10 * 1024 * 1024, 100 * 1024 * 1024};
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("bench.cfg");
+
+    for (const size_t size : sizes)
+    {
+        if (!isQuick || size <= 1024 * 1024)
+        {
+            Tests::writeFile(dir.getFilePath("bench.cfg"), Tests::generateConfig(size, 8));
+
+            printLoad<std::string>("load<string>", path, size);
+            printLoad<std::wstring>("load<wstring>", path, size);
+        }
+    }
+
+    return Tests::getFailedChecks() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/FileSystem.h"
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+using namespace Loader;
+
+
+static const FileSystem::WriteDurability kDurabilities[] =
+{
+    FileSystem::WriteDurability::None,
+    FileSystem::WriteDurability::Flush,
+    FileSystem::WriteDurability::FullSync
+};
+
+
+TEST_CASE(writeCreatesMissingFile)
+{
+    for (const auto durability : kDurabilities)
+    {
+        Tests::TempDir dir;
+        const std::string content = "[Main]\nStartupProfile=1\n";
+
+        CHECK(FileSystem::writeFileAtomically(dir.getWideFilePath("a.cfg"), content.data(), content.size(), durability));
+        CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == content);
+        CHECK(!FileSystem::isFileExist(dir.getWideFilePath("a.cfg.tmp")));
+    }
+}
+
+
+TEST_CASE(writeRenamesOverExistingFile)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), std::string(100000, 'x'));
+
+    const std::string content = "short";
+    CHECK(FileSystem::writeFileAtomically(dir.getWideFilePath("a.cfg"), content.data(), content.size(),
+        FileSystem::WriteDurability::Flush));
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == content);
+    CHECK(FileSystem::getFileSize(dir.getWideFilePath("a.cfg")) == content.size());
+}
+
+
+TEST_CASE(writeOfEmptyDataTruncatesFile)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "old");
+
+    CHECK(FileSystem::writeFileAtomically(dir.getWideFilePath("a.cfg"), "", 0, FileSystem::WriteDurability::None));
+    CHECK(FileSystem::isFileExist(dir.getWideFilePath("a.cfg")));
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")).empty());
+}
+
+
+TEST_CASE(failedTempWriteKeepsOriginal)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "original");
+    std::filesystem::create_directory(dir.getFilePath("a.cfg.tmp")); // Temporary file can not be created.
+
+    CHECK(!FileSystem::writeFileAtomically(dir.getWideFilePath("a.cfg"), "new", 3, FileSystem::WriteDurability::None));
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "original");
+}
+
+
+TEST_CASE(staleTempFileOfCrashedWriteIsReplaced)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "original");
+    Tests::writeFile(dir.getFilePath("a.cfg.tmp"), std::string(5000, 'p')); // Left by a killed writer.
+
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "original");
+    CHECK(FileSystem::writeFileAtomically(dir.getWideFilePath("a.cfg"), "new", 3, FileSystem::WriteDurability::None));
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "new");
+    CHECK(!FileSystem::isFileExist(dir.getWideFilePath("a.cfg.tmp")));
+}
+
+
+// Writer processes are killed at random moments, the file must always hold one of the complete versions.
+TEST_CASE(killedWriterNeverLeavesPartialFile)
+{
+    Tests::TempDir dir;
+    const std::string first(4 * 1024 * 1024, 'a');
+    const std::string second(3 * 1024 * 1024 + 17, 'b');
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+
+    CHECK(FileSystem::writeFileAtomically(path, first.data(), first.size(), FileSystem::WriteDurability::None));
+
+    for (int attempt = 0; attempt < 20; ++attempt)
+    {
+        const pid_t child = fork();
+
+        if (child == 0)
+        {
+            for (int i = 0; ; ++i)
+            {
+                const std::string &content = i % 2 == 0 ? second : first;
+                FileSystem::writeFileAtomically(path, content.data(), content.size(), FileSystem::WriteDurability::None);
+            }
+        }
+
+        CHECK(child > 0);
+        usleep(1000 + attempt * 700);
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+
+        const std::string content = Tests::readFile(dir.getFilePath("a.cfg"));
+        CHECK(content == first || content == second);
+    }
+}
+
+
+TEST_CASE(writeIfUnchangedDetectsConflict)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("a.cfg");
+    const FileSystem::FileInfo missing = {0, 0};
+    FileSystem::FileInfo written = {0, 0};
+
+    CHECK(FileSystem::writeFileIfUnchanged(path, "one", 3, FileSystem::WriteDurability::None, missing, &written) ==
+        FileSystem::WriteResult::Written);
+
+    FileSystem::FileInfo current = {0, 0};
+    CHECK(FileSystem::getFileInfo(path, &current));
+    CHECK(current.size == written.size && current.lastWriteTime == written.lastWriteTime);
+
+    CHECK(FileSystem::writeFileIfUnchanged(path, "two", 3, FileSystem::WriteDurability::None, missing, &written) ==
+        FileSystem::WriteResult::Conflict);
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "one");
+    CHECK(!FileSystem::isFileExist(dir.getWideFilePath("a.cfg.tmp")));
+
+    CHECK(FileSystem::writeFileIfUnchanged(path, "three", 5, FileSystem::WriteDurability::None, current, &written) ==
+        FileSystem::WriteResult::Written);
+    CHECK(Tests::readFile(dir.getFilePath("a.cfg")) == "three");
+}
+
+
+TEST_CASE(mappedFileMapsWholeContent)
+{
+    Tests::TempDir dir;
+    const std::string content(70000, 'm');
+    Tests::writeFile(dir.getFilePath("a.cfg"), content);
+
+    FileSystem::MappedFile file(dir.getWideFilePath("a.cfg"));
+    CHECK(file.isMapped());
+    CHECK(std::string(file.getData(), file.getSize()) == content);
+
+    CHECK(file.isOpened());
+
+    FileSystem::MappedFile missing(dir.getWideFilePath("missing.cfg"));
+    CHECK(!missing.isMapped());
+    CHECK(!missing.isOpened());
+}
+
+
+TEST_CASE(emptyFileIsOpenedButNotMapped)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("a.cfg"), "");
+
+    FileSystem::MappedFile file(dir.getWideFilePath("a.cfg"));
+    CHECK(file.isOpened());
+    CHECK(!file.isMapped());
+    CHECK(file.getSize() == 0);
+}
+
+
+TEST_MAIN()
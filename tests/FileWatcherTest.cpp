@@ -0,0 +1,143 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../utils/FileWatcher.h"
+#include <atomic>
+#include <csignal>
+#include <pthread.h>
+#include <thread>
+
+
+using namespace Loader;
+
+
+// Waits up to a second for 'calls' to reach 'expected'.
+static bool waitForCalls(const std::atomic<int> &calls, int expected)
+{
+    for (int attempt = 0; attempt < 100 && calls.load() < expected; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return calls.load() >= expected;
+}
+
+
+// Lets late notifications arrive before the calls are counted.
+static void settle()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+
+static std::atomic<int> receivedSignals(0);
+
+static void onSignal(int)
+{
+    receivedSignals++;
+}
+
+
+TEST_CASE(editOfWatchedFileIsReportedOnce)
+{
+    Tests::TempDir dir;
+    Tests::writeFile(dir.getFilePath("config.cfg"), "[Settings]\n");
+
+    std::atomic<int> calls(0);
+    FileWatcher watcher;
+    CHECK(watcher.start(dir.getWideFilePath(""), L"config.cfg", [&calls]() { calls++; }));
+    CHECK(watcher.isStarted());
+
+    Tests::writeFile(dir.getFilePath("config.cfg"), "[Settings]\nKey=1\n");
+    CHECK(waitForCalls(calls, 1));
+    settle();
+    CHECK(calls.load() == 1);
+
+    // Other files of the directory are ignored.
+    Tests::writeFile(dir.getFilePath("other.cfg"), "[Settings]\n");
+    settle();
+    CHECK(calls.load() == 1);
+}
+
+
+TEST_CASE(stopJoinsWaitingThread)
+{
+    Tests::TempDir dir;
+    std::atomic<int> calls(0);
+    FileWatcher watcher;
+
+    CHECK(watcher.start(dir.getWideFilePath(""), L"config.cfg", [&calls]() { calls++; }));
+    watcher.stop();
+    CHECK(!watcher.isStarted());
+    watcher.stop();
+
+    Tests::writeFile(dir.getFilePath("config.cfg"), "[Settings]\n");
+    settle();
+    CHECK(calls.load() == 0);
+
+    // Watcher can be started again after the stop.
+    CHECK(watcher.start(dir.getWideFilePath(""), L"config.cfg", [&calls]() { calls++; }));
+    Tests::writeFile(dir.getFilePath("config.cfg"), "[Settings]\nKey=1\n");
+    CHECK(waitForCalls(calls, 1));
+}
+
+
+TEST_CASE(missingDirectoryIsNotWatched)
+{
+    Tests::TempDir dir;
+    FileWatcher watcher;
+
+    CHECK(!watcher.start(dir.getWideFilePath("missing"), L"config.cfg", []() {}));
+    CHECK(!watcher.isStarted());
+}
+
+
+TEST_CASE(signalDoesNotEndWatch)
+{
+    Tests::TempDir dir;
+    std::atomic<int> calls(0);
+    FileWatcher watcher;
+
+    struct sigaction action = {};
+    action.sa_handler = &onSignal;
+    sigaction(SIGUSR1, &action, nullptr);
+
+    CHECK(watcher.start(dir.getWideFilePath(""), L"config.cfg", [&calls]() { calls++; }));
+
+    // Only the watcher thread, started before the block, can take the signal now.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    // Signal has to interrupt the wait, not the thread start.
+    settle();
+    kill(getpid(), SIGUSR1);
+    CHECK(waitForCalls(receivedSignals, 1));
+
+    Tests::writeFile(dir.getFilePath("config.cfg"), "[Settings]\n");
+    CHECK(waitForCalls(calls, 1));
+
+    watcher.stop();
+    pthread_sigmask(SIG_UNBLOCK, &signals, nullptr);
+}
+
+
+TEST_MAIN()
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../utils/LatencyHistogram.h"
+
+
+using namespace Loader;
+
+
+TEST_CASE(smallValuesHaveOwnBuckets)
+{
+    for (uint32_t value = 0; value < 2 * LatencyHistogram::kSubBuckets; ++value)
+    {
+        CHECK(LatencyHistogram::getBucketIndex(value) == value);
+        CHECK(LatencyHistogram::getBucketLowest(value) == value);
+        CHECK(LatencyHistogram::getBucketHighest(value) == value);
+    }
+
+    CHECK(LatencyHistogram::getBucketIndex(32) == 32);
+    CHECK(LatencyHistogram::getBucketIndex(33) == 32);
+    CHECK(LatencyHistogram::getBucketIndex(34) == 33);
+}
+
+
+TEST_CASE(bucketsCoverWholeRangeWithoutGaps)
+{
+    CHECK(LatencyHistogram::getBucketLowest(0) == 0);
+    CHECK(LatencyHistogram::getBucketIndex(UINT32_MAX) == LatencyHistogram::kBucketsCount - 1);
+    CHECK(LatencyHistogram::getBucketHighest(LatencyHistogram::kBucketsCount - 1) == UINT32_MAX);
+
+    for (size_t index = 0; index < LatencyHistogram::kBucketsCount; ++index)
+    {
+        const uint32_t lowest = LatencyHistogram::getBucketLowest(index);
+        const uint32_t highest = LatencyHistogram::getBucketHighest(index);
+
+        CHECK(lowest <= highest);
+        CHECK(LatencyHistogram::getBucketIndex(lowest) == index);
+        CHECK(LatencyHistogram::getBucketIndex(highest) == index);
+        // Bucket width is within 1/16 of its values.
+        CHECK(highest - lowest <= lowest / LatencyHistogram::kSubBuckets);
+
+        if (index != 0)
+        {
+            CHECK(lowest == LatencyHistogram::getBucketHighest(index - 1) + 1);
+        }
+    }
+}
+
+
+TEST_CASE(powerOfTwoStartsNewBucket)
+{
+    for (uint32_t bit = 5; bit < 32; ++bit)
+    {
+        const uint32_t power = (uint32_t)1 << bit;
+
+        CHECK(LatencyHistogram::getBucketLowest(LatencyHistogram::getBucketIndex(power)) == power);
+        CHECK(LatencyHistogram::getBucketIndex(power) == LatencyHistogram::getBucketIndex(power - 1) + 1);
+    }
+}
+
+
+TEST_CASE(emptyHistogramReportsZeros)
+{
+    LatencyHistogram histogram;
+
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getSum() == 0);
+    CHECK(histogram.getMin() == 0);
+    CHECK(histogram.getMax() == 0);
+    CHECK(histogram.getMean() == 0);
+    CHECK(histogram.getPercentile(0.0) == 0);
+    CHECK(histogram.getPercentile(50.0) == 0);
+    CHECK(histogram.getPercentile(100.0) == 0);
+}
+
+
+TEST_CASE(singleValueIsEveryPercentile)
+{
+    LatencyHistogram histogram;
+    histogram.record(1000);
+
+    // Bucket of 1000 spans 992..1023, the answer is clamped to the recorded range.
+    CHECK(LatencyHistogram::getBucketHighest(LatencyHistogram::getBucketIndex(1000)) == 1023);
+    CHECK(histogram.getPercentile(0.0) == 1000);
+    CHECK(histogram.getPercentile(50.0) == 1000);
+    CHECK(histogram.getPercentile(100.0) == 1000);
+    CHECK(histogram.getMin() == 1000 && histogram.getMax() == 1000 && histogram.getMean() == 1000);
+}
+
+
+TEST_CASE(percentilesOfExactValues)
+{
+    LatencyHistogram histogram;
+
+    for (uint32_t value = 0; value < 20; ++value)
+    {
+        histogram.record(value);
+    }
+
+    CHECK(histogram.getCount() == 20);
+    CHECK(histogram.getSum() == 190);
+    CHECK(histogram.getMean() == 9);
+    CHECK(histogram.getPercentile(0.0) == 0);
+    CHECK(histogram.getPercentile(5.0) == 0);
+    CHECK(histogram.getPercentile(50.0) == 9);
+    CHECK(histogram.getPercentile(51.0) == 10);
+    CHECK(histogram.getPercentile(100.0) == 19);
+    // Out of range percentiles are clamped.
+    CHECK(histogram.getPercentile(-1.0) == 0);
+    CHECK(histogram.getPercentile(200.0) == 19);
+}
+
+
+TEST_CASE(percentilesOfUniformValuesAreWithinBucketError)
+{
+    LatencyHistogram histogram;
+
+    for (uint32_t value = 1; value <= 10000; ++value)
+    {
+        histogram.record(value);
+    }
+
+    for (const double percentile : {50.0, 90.0, 99.0, 99.9})
+    {
+        const uint32_t exact = (uint32_t)(percentile * 100.0 + 0.5);
+        const uint32_t reported = histogram.getPercentile(percentile);
+
+        CHECK(reported >= exact);
+        CHECK(reported - exact <= exact / LatencyHistogram::kSubBuckets);
+    }
+
+    CHECK(histogram.getPercentile(0.0) == 1);
+    CHECK(histogram.getPercentile(100.0) == 10000);
+    CHECK(histogram.getMean() == 5000);
+}
+
+
+TEST_CASE(largestValuesDoNotOverflow)
+{
+    LatencyHistogram histogram;
+    histogram.record(UINT32_MAX);
+    histogram.record(UINT32_MAX);
+    histogram.record(0);
+
+    CHECK(histogram.getBucketCount(0) == 1);
+    CHECK(histogram.getBucketCount(LatencyHistogram::kBucketsCount - 1) == 2);
+    CHECK(histogram.getBucketCount(LatencyHistogram::kBucketsCount) == 0);
+    CHECK(histogram.getSum() == 2ull * UINT32_MAX);
+    CHECK(histogram.getMin() == 0);
+    CHECK(histogram.getMax() == UINT32_MAX);
+    CHECK(histogram.getPercentile(50.0) == UINT32_MAX);
+    CHECK(histogram.getPercentile(1.0) == 0);
+}
+
+
+TEST_CASE(resetForgetsValues)
+{
+    LatencyHistogram histogram;
+    histogram.record(5);
+    histogram.record(500);
+    histogram.reset();
+
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getBucketCount(5) == 0);
+    CHECK(histogram.getPercentile(50.0) == 0);
+
+    histogram.record(7);
+    CHECK(histogram.getMin() == 7 && histogram.getMax() == 7);
+}
+
+
+TEST_MAIN()
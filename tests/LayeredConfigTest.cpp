@@ -0,0 +1,131 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../utils/LayeredConfig.h"
+
+
+using namespace Loader;
+
+
+// User file on top of the machine wide file and built-in defaults, like the controller stacks them.
+struct Layers
+{
+    Tests::TempDir dir;
+    ConfigFile<std::string> user;
+    ConfigFile<std::string> machine;
+    ConfigFile<std::string> defaults;
+    LayeredConfig<std::string> config;
+
+    Layers(const std::string &userText, const std::string &machineText)
+    {
+        Tests::writeFile(dir.getFilePath("user.cfg"), userText);
+        Tests::writeFile(dir.getFilePath("machine.cfg"), machineText);
+        user.reload(dir.getWideFilePath("user.cfg"));
+        machine.reload(dir.getWideFilePath("machine.cfg"));
+
+        defaults.setValue("Main", "Delay", "100");
+        defaults.setValue("Main", "Timeout", "5000");
+        defaults.setValue("Main", "Language", "en");
+
+        config.setLayers(&user, {&machine, &defaults});
+    }
+};
+
+
+TEST_CASE(upperLayersOverrideLowerOnes)
+{
+    Layers layers("[Main]\nDelay=1\nLanguage=\n", "[Main]\nDelay=2\nTimeout=3000\nLanguage=ru\n");
+
+    CHECK(layers.config.getLayersCount() == 3);
+
+    // Machine value overrides the default one, user value overrides both.
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 1);
+    CHECK(layers.config.getValueLayer("Main", "Delay") == 0);
+    CHECK(layers.config.getValue("Main", "Timeout", 0) == 3000);
+    CHECK(layers.config.getValueLayer("Main", "Timeout") == 1);
+
+    // Empty value is missing: it does not hide lower layers.
+    CHECK(layers.config.getValue("Main", "Language") == "ru");
+    CHECK(layers.config.getValueLayer("Main", "Language") == 1);
+
+    CHECK(layers.config.getValue("Main", "Missing").empty());
+    CHECK(layers.config.getValue("Main", "Missing", 7) == 7);
+    CHECK(layers.config.getValueLayer("Main", "Missing") == 3);
+}
+
+
+TEST_CASE(writesGoToTopLayerOnly)
+{
+    Layers layers("", "[Main]\nTimeout=3000\n");
+
+    layers.config.setValue("Main", "Timeout", 10);
+    CHECK(layers.config.getValue("Main", "Timeout", 0) == 10);
+    CHECK(layers.user.getValue("Main", "Timeout") == "10");
+    CHECK(layers.machine.getValue("Main", "Timeout") == "3000");
+
+    // Cleared top value uncovers the machine one.
+    layers.config.clearValue("Main", "Timeout");
+    CHECK(layers.config.getValue("Main", "Timeout", 0) == 3000);
+    CHECK(!layers.machine.hasUnsavedChanges());
+}
+
+
+TEST_CASE(cachedValueIsRefreshedAfterTopLayerChange)
+{
+    Layers layers("", "[Main]\nDelay=2\n");
+
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 2);
+
+    layers.user.setValue("Main", "Delay", "1");
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 1);
+    CHECK(layers.config.getValueLayer("Main", "Delay") == 0);
+
+    Tests::writeFile(layers.dir.getFilePath("user.cfg"), "[Main]\n");
+    CHECK(layers.user.reload());
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 2);
+    CHECK(layers.config.getValueLayer("Main", "Delay") == 1);
+}
+
+
+TEST_CASE(cachedValueIsRefreshedAfterLowerLayerChange)
+{
+    Layers layers("[Main]\nLanguage=de\n", "[Main]\nDelay=2\n");
+
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 2);
+    CHECK(layers.config.getValue("Main", "Language") == "de");
+    CHECK(layers.config.getValue("Main", "Timeout", 0) == 5000);
+
+    // Reload replaces the stored values, cached entries must not point to the old ones.
+    Tests::writeFile(layers.dir.getFilePath("machine.cfg"), "[Main]\nDelay=20\nTimeout=1000\nLanguage=ru\n");
+    CHECK(layers.machine.reload());
+
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 20);
+    CHECK(layers.config.getValue("Main", "Timeout", 0) == 1000);
+    CHECK(layers.config.getValue("Main", "Language") == "de");
+
+    // Machine value removed again falls back to the defaults.
+    Tests::writeFile(layers.dir.getFilePath("machine.cfg"), "");
+    CHECK(layers.machine.reload());
+    CHECK(layers.config.getValue("Main", "Delay", 0) == 100);
+    CHECK(layers.config.getValueLayer("Main", "Delay") == 2);
+}
+
+
+TEST_MAIN()
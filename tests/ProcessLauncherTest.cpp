@@ -0,0 +1,76 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestRunner.h"
+#include "../utils/ProcessLauncher.h"
+#include <cstdint>
+#include <sys/wait.h>
+
+
+using namespace Loader;
+
+
+// Path of the stub executable is set by 'CMakeLists.txt'.
+static const std::wstring kStubPath = L"" STUB_AFTERBURNER_PATH;
+
+
+static int waitForExitCode(void *process)
+{
+    int status = 0;
+    const pid_t pid = (pid_t)reinterpret_cast<intptr_t>(process);
+
+    return waitpid(pid, &status, 0) == pid && WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+
+TEST_CASE(stubExitCodeIsReturned)
+{
+    std::unique_ptr<IProcessLauncher> launcher = createProcessLauncher();
+
+    for (const int profile : {0, 1, 5})
+    {
+        void *process = nullptr;
+
+        CHECK(launcher->launch(kStubPath, L"-Profile" + std::to_wstring(profile) + L" -q", &process));
+        CHECK(waitForExitCode(process) == profile);
+    }
+}
+
+
+TEST_CASE(repeatedSpacesDoNotMakeEmptyArguments)
+{
+    void *process = nullptr;
+
+    CHECK(PosixSpawnLauncher().launch(kStubPath, L"  -q   -Profile3  ", &process));
+    CHECK(waitForExitCode(process) == 3);
+}
+
+
+TEST_CASE(missingExecutableIsNotLaunched)
+{
+    Tests::TempDir dir;
+    void *process = nullptr;
+
+    CHECK(!PosixSpawnLauncher().launch(dir.getWideFilePath("missing"), L"-Profile1", &process));
+    CHECK(!PosixSpawnLauncher().launch(L"", L"-Profile1", &process));
+    CHECK(process == nullptr);
+}
+
+
+TEST_MAIN()
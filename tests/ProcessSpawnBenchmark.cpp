@@ -0,0 +1,100 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Time from the start of a stub 'MSI Afterburner' until its exit is collected:
+// 'fork' and 'execv' as the baseline against the 'posix_spawn' launcher backend.
+
+
+#include "BenchmarkRunner.h"
+#include "../utils/ProcessLauncher.h"
+#include "../utils/TextEncoding.h"
+#include <cstdint>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+using namespace Loader;
+
+
+static int forkExec(const std::string &path, const char *argument)
+{
+    int status = -1;
+    const pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        char *const argv[] = {const_cast<char*>(path.c_str()), const_cast<char*>(argument), nullptr};
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    if (pid > 0)
+    {
+        waitpid(pid, &status, 0);
+    }
+
+    return status;
+}
+
+
+static int spawn(IProcessLauncher &launcher, const std::wstring &path, const std::wstring &args)
+{
+    int status = -1;
+    void *process = nullptr;
+
+    if (launcher.launch(path, args, &process))
+    {
+        waitpid((pid_t)reinterpret_cast<intptr_t>(process), &status, 0);
+    }
+
+    return status;
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    const size_t iterations = isQuick ? 3 : 1000;
+
+    const std::wstring widePath = L"" STUB_AFTERBURNER_PATH;
+    std::string path;
+    TextEncoding::wideToUtf8(widePath.data(), widePath.size(), &path);
+
+    std::unique_ptr<IProcessLauncher> launcher = createProcessLauncher();
+    bool isExitCodeValid = true;
+
+    const Tests::Measurement baseline = Tests::measure(iterations, [&]()
+    {
+        isExitCodeValid = isExitCodeValid && forkExec(path, "-Profile1") == 1 << 8;
+    });
+
+    const Tests::Measurement current = Tests::measure(iterations, [&]()
+    {
+        isExitCodeValid = isExitCodeValid && spawn(*launcher, widePath, L"-Profile1 -q") == 1 << 8;
+    });
+
+    Tests::printComparison("spawn and wait", "stub", baseline, current);
+
+    if (!isExitCodeValid)
+    {
+        printf("Stub exited with an unexpected code\n");
+    }
+
+    return isExitCodeValid ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Hashing throughput of the portable implementation and of the x86 SHA extensions.
+
+
+#include "BenchmarkRunner.h"
+#include "../utils/Sha256.h"
+
+
+using namespace Loader;
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    // Small hashes are dominated by padding and setup, big ones by the block transform.
+    const size_t sizes[] = {64, 4 * 1024, 1024 * 1024, 64 * 1024 * 1024};
+    const bool isShaNiPresent = Sha256::isAccelerated();
+
+    if (!isShaNiPresent)
+    {
+        printf("CPU has no SHA extensions, both columns use the portable implementation\n");
+    }
+
+    for (const size_t size : sizes)
+    {
+        if (!isQuick || size <= 1024 * 1024)
+        {
+            const std::string data(size, 'h');
+            const size_t iterations = isQuick ? 2 : (size_t)(256 * 1024 * 1024) / size;
+            volatile uint8_t sink = 0;
+
+            Sha256::setAccelerationEnabled(false);
+            const Tests::Measurement portable = Tests::measure(iterations, [&]() { sink = sink + Sha256::hash(data.data(), data.size())[0]; });
+
+            Sha256::setAccelerationEnabled(true);
+            const Tests::Measurement accelerated = Tests::measure(iterations, [&]() { sink = sink + Sha256::hash(data.data(), data.size())[0]; });
+
+            const double megabytes = (double)size / (1024.0 * 1024.0);
+            printf("%-28s %-14s portable %9.1f MB/s | SHA-NI %9.1f MB/s | x%.1f\n", "hash", Tests::formatSize(size).c_str(),
+                megabytes / (portable.microseconds / 1e6), megabytes / (accelerated.microseconds / 1e6),
+                accelerated.microseconds > 0.0 ? portable.microseconds / accelerated.microseconds : 0.0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/Sha256.h"
+#include <algorithm>
+
+
+using namespace Loader;
+
+
+struct KnownAnswer
+{
+    std::string message;
+    const char *digest;
+};
+
+
+// FIPS 180-4 examples and the long message test.
+static const KnownAnswer kKnownAnswers[] =
+{
+    {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+        "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"}
+};
+
+
+static std::string hashInChunks(const std::string &message, size_t chunkSize)
+{
+    Sha256 hasher;
+
+    for (size_t pos = 0; pos < message.size(); pos += chunkSize)
+    {
+        hasher.update(message.data() + pos, (std::min)(chunkSize, message.size() - pos));
+    }
+
+    return Sha256::toHex(hasher.finish());
+}
+
+
+static void checkKnownAnswers()
+{
+    for (const auto &answer : kKnownAnswers)
+    {
+        CHECK(Sha256::toHex(Sha256::hash(answer.message.data(), answer.message.size())) == answer.digest);
+
+        // Partial blocks are buffered, whole ones go to the transform directly.
+        for (const size_t chunkSize : {1, 3, 55, 63, 64, 65, 4096})
+        {
+            if (answer.message.size() < 100000 || chunkSize >= 63)
+            {
+                CHECK(hashInChunks(answer.message, chunkSize) == answer.digest);
+            }
+        }
+    }
+}
+
+
+TEST_CASE(portableImplementationGivesKnownAnswers)
+{
+    Sha256::setAccelerationEnabled(false);
+    CHECK(!Sha256::isAccelerated());
+    checkKnownAnswers();
+    Sha256::setAccelerationEnabled(true);
+}
+
+
+TEST_CASE(shaExtensionsGiveKnownAnswers)
+{
+    Sha256::setAccelerationEnabled(true);
+
+    if (Sha256::isAccelerated())
+    {
+        checkKnownAnswers();
+    }
+    else
+    {
+        fprintf(stderr, "  CPU has no SHA extensions, only the portable implementation is checked\n");
+    }
+}
+
+
+TEST_CASE(implementationsAgreeOnEveryLength)
+{
+    std::string message;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        message.push_back((char)(i * 7 + 3));
+    }
+
+    // Padding of every message length up to several blocks.
+    bool isSame = true;
+
+    for (size_t size = 0; size <= message.size() && isSame; ++size)
+    {
+        Sha256::setAccelerationEnabled(false);
+        const Sha256::Digest portable = Sha256::hash(message.data(), size);
+        Sha256::setAccelerationEnabled(true);
+        const Sha256::Digest accelerated = Sha256::hash(message.data(), size);
+
+        isSame = portable == accelerated;
+    }
+
+    CHECK(isSame);
+
+    // State is shared by both implementations, switching between blocks keeps the result.
+    Sha256 hasher;
+    hasher.update(message.data(), 100);
+    Sha256::setAccelerationEnabled(false);
+    hasher.update(message.data() + 100, 200);
+    Sha256::setAccelerationEnabled(true);
+    CHECK(hasher.finish() == Sha256::hash(message.data(), 300));
+}
+
+
+TEST_CASE(hexRoundTrip)
+{
+    const std::wstring hex = L"BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD";
+    Sha256::Digest digest = {0};
+
+    CHECK(Sha256::fromHex(hex, &digest));
+    CHECK(Sha256::toHex(digest) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(!Sha256::fromHex(hex.substr(1), &digest));
+    CHECK(!Sha256::fromHex(hex.substr(1) + L"g", &digest));
+    CHECK(!Sha256::fromHex(hex + L"0", &digest));
+}
+
+
+TEST_MAIN()
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/SignatureCache.h"
+
+
+using namespace Loader;
+
+
+// Stub of the signature check: counts calls and returns the configured result.
+struct StubVerifier
+{
+    bool isValid = true;
+    int calls = 0;
+
+    SignatureCache::Verifier get()
+    {
+        return [this]() { calls++; return isValid; };
+    }
+};
+
+
+static FileSystem::FileIdentity makeIdentity(uint8_t fileId)
+{
+    FileSystem::FileIdentity identity = {};
+    identity.volumeId = 7;
+    identity.fileId[0] = fileId;
+    identity.size = 1000;
+    identity.lastWriteTime = 132000000000000000ull;
+    return identity;
+}
+
+
+static Sha256::Digest makeHash(const std::string &content)
+{
+    return Sha256::hash(content.data(), content.size());
+}
+
+
+TEST_CASE(verifiedFileIsHitUntilChanged)
+{
+    Tests::TempDir dir;
+    SignatureCache cache(dir.getWideFilePath("cache.bin"));
+    StubVerifier verifier;
+
+    FileSystem::FileIdentity identity = makeIdentity(1);
+    Sha256::Digest hash = makeHash("build 1");
+
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(verifier.calls == 1);
+    CHECK(cache.getMisses() == 1 && cache.getHits() == 1);
+
+    // Every part of the file state invalidates the entry.
+    identity.size++;
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(verifier.calls == 2);
+
+    identity.lastWriteTime++;
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(verifier.calls == 3);
+
+    hash = makeHash("build 2");
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(verifier.calls == 4);
+
+    CHECK(cache.isTrusted(identity, hash, verifier.get()));
+    CHECK(verifier.calls == 4);
+
+    // Other file with the same content is verified on its own.
+    CHECK(cache.isTrusted(makeIdentity(2), hash, verifier.get()));
+    CHECK(verifier.calls == 5);
+    CHECK(cache.getMisses() == 5 && cache.getHits() == 2);
+}
+
+
+TEST_CASE(failedVerificationIsNotRemembered)
+{
+    Tests::TempDir dir;
+    SignatureCache cache(dir.getWideFilePath("cache.bin"));
+    StubVerifier verifier;
+    verifier.isValid = false;
+
+    CHECK(!cache.isTrusted(makeIdentity(1), makeHash("bad"), verifier.get()));
+    CHECK(!cache.isTrusted(makeIdentity(1), makeHash("bad"), verifier.get()));
+    CHECK(verifier.calls == 2);
+    CHECK(!FileSystem::isFileExist(dir.getWideFilePath("cache.bin")));
+}
+
+
+TEST_CASE(notPinnedContentIsRejectedWithoutVerification)
+{
+    Tests::TempDir dir;
+    SignatureCache cache(dir.getWideFilePath("cache.bin"));
+    StubVerifier verifier;
+
+    const Sha256::Digest goodHash = makeHash("pinned build");
+    const Sha256::Digest otherHash = makeHash("other build");
+
+    CHECK(cache.isTrusted(makeIdentity(1), otherHash, verifier.get()));
+    CHECK(!cache.hasPinnedHashes());
+    cache.setPinnedHashes({goodHash});
+    CHECK(cache.hasPinnedHashes());
+
+    // Even a cached file is rejected once its content is not pinned.
+    CHECK(!cache.isTrusted(makeIdentity(1), otherHash, verifier.get()));
+    CHECK(!cache.isTrusted(makeIdentity(2), otherHash, verifier.get()));
+    CHECK(verifier.calls == 1);
+    CHECK(cache.getRejected() == 2);
+
+    // Pinned content still needs a valid signature.
+    verifier.isValid = false;
+    CHECK(!cache.isTrusted(makeIdentity(3), goodHash, verifier.get()));
+    verifier.isValid = true;
+    CHECK(cache.isTrusted(makeIdentity(3), goodHash, verifier.get()));
+    CHECK(verifier.calls == 3);
+
+    cache.setPinnedHashes({});
+    CHECK(!cache.hasPinnedHashes());
+    CHECK(cache.isTrusted(makeIdentity(1), otherHash, verifier.get()));
+    CHECK(verifier.calls == 3);
+}
+
+
+TEST_CASE(entriesPersistBetweenInstances)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("cache.bin");
+    StubVerifier verifier;
+
+    {
+        SignatureCache cache(path);
+        for (uint8_t i = 0; i < 20; ++i)
+        {
+            CHECK(cache.isTrusted(makeIdentity(i), makeHash("build"), verifier.get()));
+        }
+    }
+
+    CHECK(verifier.calls == 20);
+
+    {
+        SignatureCache cache(path);
+
+        // Only the newest 16 entries are kept.
+        for (uint8_t i = 4; i < 20; ++i)
+        {
+            CHECK(cache.isTrusted(makeIdentity(i), makeHash("build"), verifier.get()));
+        }
+
+        CHECK(verifier.calls == 20);
+        CHECK(cache.getHits() == 16);
+
+        CHECK(cache.isTrusted(makeIdentity(0), makeHash("build"), verifier.get()));
+        CHECK(verifier.calls == 21);
+    }
+}
+
+
+TEST_CASE(brokenCacheFileIsIgnored)
+{
+    Tests::TempDir dir;
+    const std::wstring path = dir.getWideFilePath("cache.bin");
+    StubVerifier verifier;
+
+    {
+        SignatureCache cache(path);
+        CHECK(cache.isTrusted(makeIdentity(1), makeHash("build"), verifier.get()));
+    }
+
+    // Truncated file: header promises more entries than there are.
+    const std::string content = Tests::readFile(dir.getFilePath("cache.bin"));
+    Tests::writeFile(dir.getFilePath("cache.bin"), content.substr(0, content.size() - 1));
+
+    {
+        SignatureCache cache(path);
+        CHECK(cache.isTrusted(makeIdentity(1), makeHash("build"), verifier.get()));
+        CHECK(verifier.calls == 2);
+    }
+
+    // Rewritten by the successful verification.
+    {
+        SignatureCache cache(path);
+        CHECK(cache.isTrusted(makeIdentity(1), makeHash("build"), verifier.get()));
+        CHECK(verifier.calls == 2);
+    }
+}
+
+
+TEST_MAIN()
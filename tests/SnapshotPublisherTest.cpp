@@ -0,0 +1,177 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Also meant to be run with '-DLOADER_TESTS_TSAN=ON'.
+
+
+#include "TestRunner.h"
+#include "../utils/SnapshotPublisher.h"
+#include <string>
+#include <vector>
+
+
+using namespace Loader;
+
+
+static std::atomic<int> liveValues(0);
+
+
+// Fields are checked against each other, a torn or freed value breaks them.
+struct Value
+{
+    Value(uint32_t writer, uint32_t sequence)
+        : writer(writer)
+        , sequence(sequence)
+        , text(std::to_string(writer) + ":" + std::to_string(sequence))
+    {
+        liveValues++;
+    }
+
+    ~Value()
+    {
+        liveValues--;
+    }
+
+    bool isConsistent() const
+    {
+        return text == std::to_string(writer) + ":" + std::to_string(sequence);
+    }
+
+    const uint32_t writer;
+    const uint32_t sequence;
+    const std::string text;
+};
+
+
+TEST_CASE(emptyUntilPublished)
+{
+    {
+        SnapshotPublisher<Value> publisher;
+        CHECK(publisher.acquire().empty());
+
+        publisher.publish(1u, 2u);
+        const SnapshotPublisher<Value>::Snapshot first = publisher.acquire();
+        CHECK(!first.empty() && first->sequence == 2);
+
+        publisher.publish(1u, 3u);
+        CHECK(publisher.acquire()->sequence == 3);
+        CHECK(first->sequence == 2); // Replaced version lives while its snapshot exists.
+        CHECK(liveValues == 2);
+        CHECK(publisher.getPublishedVersions() == 2);
+    }
+
+    CHECK(liveValues == 0);
+}
+
+
+TEST_CASE(concurrentAcquireAndPublish)
+{
+    const uint32_t writersCount = 2;
+    const uint32_t readersCount = 6;
+    const uint32_t publications = 20000;
+
+    {
+        SnapshotPublisher<Value> publisher;
+        std::atomic<uint32_t> activeWriters(writersCount);
+        std::atomic<uint32_t> startedReaders(0);
+        std::atomic<bool> isBroken(false);
+        std::vector<std::thread> threads;
+
+        for (uint32_t writer = 0; writer < writersCount; ++writer)
+        {
+            threads.emplace_back([&publisher, &activeWriters, &startedReaders, writer, readersCount, publications]()
+            {
+                while (startedReaders != readersCount)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint32_t sequence = 1; sequence <= publications; ++sequence)
+                {
+                    publisher.publish(writer, sequence);
+                }
+
+                activeWriters--;
+            });
+        }
+
+        for (uint32_t reader = 0; reader < readersCount; ++reader)
+        {
+            threads.emplace_back([&publisher, &activeWriters, &startedReaders, &isBroken, reader, writersCount]()
+            {
+                // Versions of one writer are seen in its order of publication.
+                std::vector<uint32_t> lastSequences(writersCount, 0);
+                std::vector<SnapshotPublisher<Value>::Snapshot> held;
+                uint32_t iteration = 0;
+
+                startedReaders++;
+
+                while (activeWriters != 0)
+                {
+                    SnapshotPublisher<Value>::Snapshot snapshot = publisher.acquire();
+
+                    if (!snapshot.empty())
+                    {
+                        if (!snapshot->isConsistent() || snapshot->writer >= writersCount ||
+                            snapshot->sequence < lastSequences[snapshot->writer])
+                        {
+                            isBroken = true;
+                        }
+                        else
+                        {
+                            lastSequences[snapshot->writer] = snapshot->sequence;
+                        }
+
+                        // Some snapshots outlive several publications and are released out of order.
+                        if (++iteration % (reader + 3) == 0)
+                        {
+                            held.push_back(snapshot);
+                        }
+
+                        if (held.size() > 16)
+                        {
+                            held.erase(held.begin() + (iteration % held.size()));
+                        }
+                    }
+
+                    for (const auto &old : held)
+                    {
+                        isBroken = isBroken || !old->isConsistent();
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK(!isBroken);
+        CHECK(publisher.getPublishedVersions() == writersCount * publications);
+        CHECK(liveValues == 1); // Only the current version, every replaced one is released.
+    }
+
+    CHECK(liveValues == 0);
+}
+
+
+TEST_MAIN()
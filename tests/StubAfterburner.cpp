@@ -0,0 +1,47 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Stand-in for 'MSI Afterburner' in launcher tests: "-ProfileN" exits with code N,
+// "-Sleep<milliseconds>" waits before the exit. Other arguments, like "-q", are ignored.
+
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+
+int main(int argc, char **argv)
+{
+    int exitCode = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "-Profile", 8) == 0)
+        {
+            exitCode = atoi(argv[i] + 8);
+        }
+        else if (strncmp(argv[i], "-Sleep", 6) == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(atoi(argv[i] + 6)));
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __TESTS_TEST_RUNNER_H__
+#define __TESTS_TEST_RUNNER_H__
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace Loader
+{
+
+namespace Tests
+{
+    typedef void(*TestFunction)();
+
+    struct TestCase
+    {
+        const char *name;
+        TestFunction function;
+    };
+
+    inline std::vector<TestCase>& getTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    inline int& getFailedChecks()
+    {
+        static int failedChecks = 0;
+        return failedChecks;
+    }
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char *name, TestFunction function)
+        {
+            getTestCases().push_back(TestCase{name, function});
+        }
+    };
+
+    inline void reportFailure(const char *file, int line, const char *expression)
+    {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        getFailedChecks()++;
+    }
+
+    // Runs all registered tests, or only the ones whose names are given in the command line.
+    inline int runTests(int argc, char **argv)
+    {
+        int failedTests = 0;
+
+        for (const auto &testCase : getTestCases())
+        {
+            bool isSelected = argc < 2;
+
+            for (int i = 1; i < argc && !isSelected; ++i)
+            {
+                isSelected = strcmp(argv[i], testCase.name) == 0;
+            }
+
+            if (isSelected)
+            {
+                const int failedBefore = getFailedChecks();
+                const auto startTime = std::chrono::steady_clock::now();
+
+                testCase.function();
+
+                const bool isPassed = getFailedChecks() == failedBefore;
+                failedTests += isPassed ? 0 : 1;
+
+                printf("%s %s (%lld ms)\n", isPassed ? "[  OK  ]" : "[ FAIL ]", testCase.name,
+                    (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+            }
+        }
+
+        return failedTests == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Unique directory removed with its content on destruction.
+    class TempDir
+    {
+    public:
+        TempDir()
+        {
+            std::string pattern = (std::filesystem::temp_directory_path() / "loader-test-XXXXXX").string();
+            path = mkdtemp(&pattern[0]) != nullptr ? pattern : std::string();
+        }
+
+        ~TempDir()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        std::string getFilePath(const std::string &name) const
+        {
+            return path + "/" + name;
+        }
+
+        std::wstring getWideFilePath(const std::string &name) const
+        {
+            const std::string filePath = getFilePath(name);
+            return std::wstring(filePath.begin(), filePath.end()); // Test paths are ASCII.
+        }
+
+    private:
+        std::string path;
+    };
+
+    inline std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    inline void writeFile(const std::string &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), (std::streamsize)content.size());
+    }
+}
+
+}
+
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const Loader::Tests::TestRegistrar name##Registrar(#name, &name); \
+    static void name()
+
+#define CHECK(expression) \
+    ((expression) ? (void)0 : Loader::Tests::reportFailure(__FILE__, __LINE__, #expression))
+
+#define TEST_MAIN() \
+    int main(int argc, char **argv) { return Loader::Tests::runTests(argc, argv); }
+
+
+#endif
+
+
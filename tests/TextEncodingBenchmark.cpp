@@ -0,0 +1,148 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// Transcoding throughput. Baseline is the 'codecvt' facet of the 'C.UTF-8' locale,
+// the original config reader decoded files with it through an imbued 'std::wifstream'.
+
+
+#include "BenchmarkRunner.h"
+#include "../utils/TextEncoding.h"
+#include <locale>
+
+
+using namespace Loader;
+
+
+typedef std::codecvt<wchar_t, char, std::mbstate_t> CodecvtType;
+
+
+// Config like text: ASCII keys with some values in Cyrillic.
+static std::string generateText(size_t size, bool isAsciiOnly)
+{
+    std::string text;
+
+    for (size_t line = 0; text.size() < size; ++line)
+    {
+        text += "Key" + std::to_string(line) + "=";
+        text += isAsciiOnly || line % 4 ? "Value " + std::to_string(line * 31) : std::string("\xD0\x9F\xD1\x80\xD0\xBE\xD1\x84\xD0\xB8\xD0\xBB\xD1\x8C");
+        text += "\r\n";
+    }
+
+    text.resize(size - (size >= 2 ? 2 : 0));
+    text += "\r\n";
+
+    return text;
+}
+
+
+static void codecvtToWide(const CodecvtType &codecvt, const std::string &bytes, std::wstring *outText)
+{
+    std::mbstate_t state = {};
+    const char *next = nullptr;
+    wchar_t *outNext = nullptr;
+
+    outText->resize(bytes.size());
+    codecvt.in(state, bytes.data(), bytes.data() + bytes.size(), next, &(*outText)[0], &(*outText)[0] + outText->size(), outNext);
+    outText->resize((size_t)(outNext - outText->data()));
+}
+
+
+static void codecvtToUtf8(const CodecvtType &codecvt, const std::wstring &text, std::string *outBytes)
+{
+    std::mbstate_t state = {};
+    const wchar_t *next = nullptr;
+    char *outNext = nullptr;
+
+    outBytes->resize(text.size() * 4);
+    codecvt.out(state, text.data(), text.data() + text.size(), next, &(*outBytes)[0], &(*outBytes)[0] + outBytes->size(), outNext);
+    outBytes->resize((size_t)(outNext - outBytes->data()));
+}
+
+
+static void printThroughput(const char *name, const std::string &input, size_t size,
+    const Tests::Measurement &baseline, const Tests::Measurement &current)
+{
+    const double megabytes = (double)size / (1024.0 * 1024.0);
+
+    printf("%-28s %-14s baseline %9.1f MB/s | current %9.1f MB/s | x%.1f\n", name, input.c_str(),
+        megabytes / (baseline.microseconds / 1e6), megabytes / (current.microseconds / 1e6),
+        current.microseconds > 0.0 ? baseline.microseconds / current.microseconds : 0.0);
+}
+
+
+static void printThroughput(const char *name, const std::string &input, size_t size, const Tests::Measurement &measurement)
+{
+    printf("%-28s %-14s %9.1f MB/s\n", name, input.c_str(), (double)size / (1024.0 * 1024.0) / (measurement.microseconds / 1e6));
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+    const size_t size = isQuick ? 64 * 1024 : 4 * 1024 * 1024;
+    const size_t iterations = isQuick ? 2 : 100;
+
+    const std::locale locale("C.UTF-8");
+    const CodecvtType &codecvt = std::use_facet<CodecvtType>(locale);
+
+    for (const bool isAsciiOnly : {true, false})
+    {
+        const std::string bytes = generateText(size, isAsciiOnly);
+        const std::string input = Tests::formatSize(size) + (isAsciiOnly ? " ASCII" : " mixed");
+
+        std::wstring wideText;
+        std::string narrowText;
+
+        const Tests::Measurement baselineToWide = Tests::measure(iterations, [&]() { codecvtToWide(codecvt, bytes, &wideText); });
+        const Tests::Measurement toWide = Tests::measure(iterations, [&]()
+        {
+            wideText.clear();
+            TextEncoding::utf8ToWide(bytes.data(), bytes.size(), &wideText);
+        });
+        printThroughput("UTF-8 to wide", input, bytes.size(), baselineToWide, toWide);
+
+        const Tests::Measurement baselineToUtf8 = Tests::measure(iterations, [&]() { codecvtToUtf8(codecvt, wideText, &narrowText); });
+        const Tests::Measurement toUtf8 = Tests::measure(iterations, [&]()
+        {
+            narrowText.clear();
+            TextEncoding::wideToUtf8(wideText.data(), wideText.size(), &narrowText);
+        });
+        printThroughput("wide to UTF-8", input, bytes.size(), baselineToUtf8, toUtf8);
+
+        // UTF-16 files were not supported before, there is no baseline. Rate is of the UTF-16 input.
+        // Wide strings are UTF-32 here, so every unit is checked for surrogates, unlike the copy of Windows.
+        for (const auto encoding : {TextEncoding::Encoding::Utf16LE, TextEncoding::Encoding::Utf16BE})
+        {
+            std::string utf16Bytes;
+            TextEncoding::encode(bytes, encoding, &utf16Bytes);
+
+            const Tests::Measurement decodeUtf16 = Tests::measure(iterations, [&]()
+            {
+                wideText.clear();
+                TextEncoding::decode(utf16Bytes.data() + 2, utf16Bytes.size() - 2, encoding, &wideText);
+            });
+            printThroughput(encoding == TextEncoding::Encoding::Utf16LE ? "UTF-16LE to wide" : "UTF-16BE to wide",
+                input, utf16Bytes.size(), decodeUtf16);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/TextEncoding.h"
+
+
+using namespace Loader;
+
+
+static const std::string kReplacement = "\xEF\xBF\xBD";
+static const std::wstring kWideReplacement = L"\uFFFD";
+
+// One character of every UTF-8 length: 'A', 'é', '✓', '😀'.
+static const std::string kMixedUtf8 = "A\xC3\xA9\xE2\x9C\x93\xF0\x9F\x98\x80";
+static const std::wstring kMixedWide = L"A\u00E9\u2713\U0001F600";
+
+
+static std::wstring toWide(const std::string &bytes)
+{
+    std::wstring text;
+    TextEncoding::utf8ToWide(bytes.data(), bytes.size(), &text);
+    return text;
+}
+
+
+static std::string toUtf8(const std::wstring &text)
+{
+    std::string bytes;
+    TextEncoding::wideToUtf8(text.data(), text.size(), &bytes);
+    return bytes;
+}
+
+
+template<typename StringType>
+static StringType decode(const std::string &bytes)
+{
+    size_t bomSize = 0;
+    const TextEncoding::Encoding encoding = TextEncoding::detect(bytes.data(), bytes.size(), &bomSize);
+
+    StringType text;
+    TextEncoding::decode(bytes.data() + bomSize, bytes.size() - bomSize, encoding, &text);
+    return text;
+}
+
+
+template<typename StringType>
+static std::string encode(const StringType &text, TextEncoding::Encoding encoding)
+{
+    std::string bytes;
+    TextEncoding::encode(text, encoding, &bytes);
+    return bytes;
+}
+
+
+TEST_CASE(detectsEncodingByBom)
+{
+    size_t bomSize = 99;
+
+    CHECK(TextEncoding::detect("abc", 3, &bomSize) == TextEncoding::Encoding::Utf8 && bomSize == 0);
+    CHECK(TextEncoding::detect("", 0, &bomSize) == TextEncoding::Encoding::Utf8 && bomSize == 0);
+    CHECK(TextEncoding::detect("\xEF\xBB\xBF" "a", 4, &bomSize) == TextEncoding::Encoding::Utf8Bom && bomSize == 3);
+    CHECK(TextEncoding::detect("\xFF\xFE", 2, &bomSize) == TextEncoding::Encoding::Utf16LE && bomSize == 2);
+    CHECK(TextEncoding::detect("\xFE\xFF\x00" "a", 4, &bomSize) == TextEncoding::Encoding::Utf16BE && bomSize == 2);
+    // Truncated BOM is plain UTF-8 content.
+    CHECK(TextEncoding::detect("\xEF\xBB", 2, &bomSize) == TextEncoding::Encoding::Utf8 && bomSize == 0);
+    CHECK(TextEncoding::detect("\xFF", 1, &bomSize) == TextEncoding::Encoding::Utf8 && bomSize == 0);
+}
+
+
+TEST_CASE(convertsAllLengthsOfUtf8)
+{
+    CHECK(toWide(kMixedUtf8) == kMixedWide);
+    CHECK(toUtf8(kMixedWide) == kMixedUtf8);
+
+    // Boundary code points of every sequence length.
+    CHECK(toWide("\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF0\x90\x80\x80\xF4\x8F\xBF\xBF") ==
+        L"\x7F\x80\u07FF\u0800\uFFFF\U00010000\U0010FFFF");
+    CHECK(toUtf8(L"\x7F\x80\u07FF\u0800\uFFFF\U00010000\U0010FFFF") ==
+        "\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF0\x90\x80\x80\xF4\x8F\xBF\xBF");
+}
+
+
+TEST_CASE(everyCodePointRoundTrips)
+{
+    bool isRoundTripped = true;
+
+    for (uint32_t codePoint = 1; codePoint <= 0x10FFFF && isRoundTripped; ++codePoint)
+    {
+        if (codePoint < 0xD800 || codePoint > 0xDFFF)
+        {
+            std::wstring text;
+            if (sizeof(wchar_t) == 2 && codePoint >= 0x10000)
+            {
+                text.push_back((wchar_t)(0xD800 + ((codePoint - 0x10000) >> 10)));
+                text.push_back((wchar_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF)));
+            }
+            else
+            {
+                text.push_back((wchar_t)codePoint);
+            }
+
+            isRoundTripped = toWide(toUtf8(text)) == text &&
+                decode<std::wstring>(encode(text, TextEncoding::Encoding::Utf16BE)) == text;
+        }
+    }
+
+    CHECK(isRoundTripped);
+}
+
+
+TEST_CASE(invalidUtf8IsReplaced)
+{
+    CHECK(toWide("a\x80z") == L"a\uFFFDz");                 // Lone continuation byte.
+    CHECK(toWide("a\xC0\xAFz") == L"a\uFFFD\uFFFDz");        // Overlong, invalid lead byte.
+    CHECK(toWide("a\xE0\x80\xAFz") == L"a\uFFFDz");         // Overlong three byte sequence.
+    CHECK(toWide("a\xED\xA0\x80z") == L"a\uFFFDz");         // Encoded surrogate.
+    CHECK(toWide("a\xF4\x90\x80\x80z") == L"a\uFFFDz");     // Above U+10FFFF.
+    CHECK(toWide("a\xF5\x80z") == L"a\uFFFD\uFFFDz");        // Invalid lead byte.
+    CHECK(toWide("a\xE2\x9Cz") == L"a\uFFFDz");             // Truncated by ASCII.
+    CHECK(toWide("a\xE2\x9C") == L"a\uFFFD");               // Truncated by the end.
+    CHECK(toWide("\xF0\x9F\x98") == kWideReplacement);
+}
+
+
+TEST_CASE(invalidWideTextIsReplaced)
+{
+    std::wstring unpaired = L"a";
+    unpaired.push_back((wchar_t)0xD800);
+    unpaired.push_back(L'z');
+    CHECK(toUtf8(unpaired) == "a" + kReplacement + "z");
+
+    std::wstring lowFirst = L"a";
+    lowFirst.push_back((wchar_t)0xDC00);
+    lowFirst.push_back((wchar_t)0xD800);
+    CHECK(toUtf8(lowFirst) == "a" + kReplacement + kReplacement);
+}
+
+
+TEST_CASE(nonAsciiAtEveryVectorOffset)
+{
+    // SSE2 path converts 16 characters at once, other characters may start anywhere in a chunk.
+    for (size_t prefix = 0; prefix < 40; ++prefix)
+    {
+        const std::string bytes = std::string(prefix, 'x') + kMixedUtf8 + std::string(prefix % 17, 'y') + kMixedUtf8;
+        const std::wstring text = std::wstring(prefix, L'x') + kMixedWide + std::wstring(prefix % 17, L'y') + kMixedWide;
+
+        CHECK(toWide(bytes) == text);
+        CHECK(toUtf8(text) == bytes);
+        CHECK(toWide(std::string(prefix, 'x') + "\xE2\x9C") == std::wstring(prefix, L'x') + kWideReplacement);
+    }
+}
+
+
+TEST_CASE(outputIsAppended)
+{
+    std::wstring text = L"keep ";
+    TextEncoding::utf8ToWide("\xC3\xA9", 2, &text);
+    CHECK(text == L"keep \u00E9");
+
+    std::string bytes = "keep ";
+    TextEncoding::wideToUtf8(L"\u00E9", 1, &bytes);
+    CHECK(bytes == "keep \xC3\xA9");
+}
+
+
+TEST_CASE(encodesUtf16WithBom)
+{
+    const std::string littleEndian("\xFF\xFE" "A\x00\xE9\x00\x13\x27\x3D\xD8\x00\xDE", 12);
+    const std::string bigEndian("\xFE\xFF\x00" "A\x00\xE9\x27\x13\xD8\x3D\xDE\x00", 12);
+
+    CHECK(encode(kMixedUtf8, TextEncoding::Encoding::Utf16LE) == littleEndian);
+    CHECK(encode(kMixedWide, TextEncoding::Encoding::Utf16LE) == littleEndian);
+    CHECK(encode(kMixedUtf8, TextEncoding::Encoding::Utf16BE) == bigEndian);
+    CHECK(encode(kMixedWide, TextEncoding::Encoding::Utf16BE) == bigEndian);
+
+    CHECK(decode<std::string>(littleEndian) == kMixedUtf8);
+    CHECK(decode<std::wstring>(littleEndian) == kMixedWide);
+    CHECK(decode<std::string>(bigEndian) == kMixedUtf8);
+    CHECK(decode<std::wstring>(bigEndian) == kMixedWide);
+}
+
+
+TEST_CASE(invalidUtf16IsReplaced)
+{
+    // Unpaired high and low surrogates, then an odd trailing byte.
+    const std::string littleEndian("\xFF\xFE" "a\x00\x00\xD8" "b\x00\x00\xDC" "c", 11);
+    CHECK(decode<std::string>(littleEndian) == "a" + kReplacement + "b" + kReplacement);
+
+    const std::string bigEndian("\xFE\xFF\x00" "a\xD8\x00", 6);
+    CHECK(decode<std::string>(bigEndian) == "a" + kReplacement);
+}
+
+
+TEST_CASE(allEncodingsRoundTrip)
+{
+    const TextEncoding::Encoding encodings[] =
+    {
+        TextEncoding::Encoding::Utf8,
+        TextEncoding::Encoding::Utf8Bom,
+        TextEncoding::Encoding::Utf16LE,
+        TextEncoding::Encoding::Utf16BE
+    };
+
+    std::string text;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        text += i % 7 ? "[Profile" + std::to_string(i) + "]\r\n" : kMixedUtf8;
+    }
+
+    for (const auto encoding : encodings)
+    {
+        const std::string bytes = encode(text, encoding);
+        CHECK(decode<std::string>(bytes) == text);
+        CHECK(decode<std::wstring>(bytes) == toWide(text));
+        CHECK(encode(toWide(text), encoding) == bytes);
+    }
+
+    CHECK(encode(text, TextEncoding::Encoding::Utf8Bom) == "\xEF\xBB\xBF" + text);
+    CHECK(encode(text, TextEncoding::Encoding::Utf8) == text);
+}
+
+
+TEST_MAIN()
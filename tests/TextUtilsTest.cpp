@@ -0,0 +1,158 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/TextUtils.h"
+#include <cctype>
+
+
+using namespace Loader;
+
+
+template<typename CharType>
+static std::basic_string_view<CharType> trimNaive(std::basic_string_view<CharType> str)
+{
+    while (!str.empty() && TextUtils::isSpace(str.front()))
+    {
+        str.remove_prefix(1);
+    }
+
+    while (!str.empty() && TextUtils::isSpace(str.back()))
+    {
+        str.remove_suffix(1);
+    }
+
+    return str;
+}
+
+
+TEST_CASE(asciiSpacesMatchClassicLocale)
+{
+    for (int ch = 0; ch < 128; ++ch)
+    {
+        const bool isSpace = std::isspace(ch) != 0;
+
+        CHECK(TextUtils::isSpace((char)ch) == isSpace);
+        CHECK(TextUtils::isSpace((wchar_t)ch) == isSpace);
+    }
+}
+
+
+TEST_CASE(unicodeSpacesOfWideText)
+{
+    const wchar_t spaces[] = {0x85, 0xA0, 0x1680, 0x2000, 0x2005, 0x200A, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000};
+    const wchar_t nonSpaces[] = {0x80, 0xA1, 0x200B, 0x2010, 0x200, 0x0439, 0xFEFF, 0xFFFD};
+
+    for (const wchar_t ch : spaces)
+    {
+        CHECK(TextUtils::isSpace(ch));
+    }
+
+    for (const wchar_t ch : nonSpaces)
+    {
+        CHECK(!TextUtils::isSpace(ch));
+    }
+}
+
+
+TEST_CASE(bytesOfUtf8SequencesAreNotSpaces)
+{
+    for (int ch = 0x80; ch < 0x100; ++ch)
+    {
+        CHECK(!TextUtils::isSpace((char)ch));
+    }
+
+    // U+00A0 in UTF-8 is two bytes, none of them is a space on its own.
+    CHECK(TextUtils::trim(std::string_view("\xC2\xA0x\xC2\xA0")) == "\xC2\xA0x\xC2\xA0");
+}
+
+
+// Lengths around the 16 byte blocks of the vectorized path.
+TEST_CASE(trimMatchesScalarOnAllBlockBoundaries)
+{
+    const char spaces[] = " \t\r\n\v\f";
+
+    for (size_t leading = 0; leading < 40; ++leading)
+    {
+        for (size_t body = 0; body < 20; ++body)
+        {
+            for (size_t trailing = 0; trailing < 40; trailing += 3)
+            {
+                std::string text;
+                std::wstring wideText;
+
+                for (size_t i = 0; i < leading; ++i)
+                {
+                    text += spaces[i % 6];
+                }
+
+                for (size_t i = 0; i < body; ++i)
+                {
+                    text += i % 4 == 1 ? ' ' : (char)('a' + i);
+                }
+
+                for (size_t i = 0; i < trailing; ++i)
+                {
+                    text += spaces[(i + 3) % 6];
+                }
+
+                wideText.assign(text.begin(), text.end());
+
+                CHECK(TextUtils::trim(std::string_view(text)) == trimNaive(std::string_view(text)));
+                CHECK(TextUtils::trim(std::wstring_view(wideText)) == trimNaive(std::wstring_view(wideText)));
+            }
+        }
+    }
+}
+
+
+TEST_CASE(trimOfWideUnicodeSpaces)
+{
+    const std::wstring text = std::wstring(20, (wchar_t)0x3000) + L" \x2028value\x00A0 x" + std::wstring(17, (wchar_t)0x2002);
+
+    CHECK(TextUtils::trim(std::wstring_view(text)) == L"value\x00A0 x");
+    CHECK(TextUtils::trimLeft(std::wstring_view(L"  a  ")) == L"a  ");
+    CHECK(TextUtils::trimRight(std::wstring_view(L"  a  ")) == L"  a");
+    CHECK(TextUtils::trim(std::wstring_view(L" \t ")).empty());
+}
+
+
+TEST_CASE(parseIntLikeStoi)
+{
+    int32_t value = 0;
+
+    CHECK(TextUtils::parseInt(std::string_view("  42"), &value) && value == 42);
+    CHECK(TextUtils::parseInt(std::string_view("-17abc"), &value) && value == -17);
+    CHECK(TextUtils::parseInt(std::wstring_view(L"+5 "), &value) && value == 5);
+    CHECK(TextUtils::parseInt(std::string_view("2147483647"), &value) && value == INT32_MAX);
+    CHECK(TextUtils::parseInt(std::string_view("-2147483648"), &value) && value == INT32_MIN);
+
+    value = 3;
+    CHECK(!TextUtils::parseInt(std::string_view("2147483648"), &value));
+    CHECK(!TextUtils::parseInt(std::string_view("-2147483649"), &value));
+    CHECK(!TextUtils::parseInt(std::string_view("abc"), &value));
+    CHECK(!TextUtils::parseInt(std::string_view("-"), &value));
+    CHECK(!TextUtils::parseInt(std::string_view(""), &value));
+    CHECK(value == 3);
+}
+
+
+TEST_MAIN()
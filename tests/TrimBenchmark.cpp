@@ -0,0 +1,92 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+// 'TextUtils::trim' against the original locale based trimming of config lines.
+
+
+#include "BaselineConfigFile.h"
+#include "BenchmarkRunner.h"
+#include "../utils/TextUtils.h"
+#include <vector>
+
+
+using namespace Loader;
+
+
+template<typename StringType>
+static std::vector<StringType> generateLines(size_t count)
+{
+    std::vector<StringType> lines;
+    const char *samples[] = {"Name=Profile 1", "  Enabled = 1  ", "\t[Profile5]\r", "StartupDelay=10\r",
+        "                        AfterburnerDirPath = C:\\Program Files (x86)\\MSI Afterburner      \r", "", "   "};
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const std::string sample = samples[i % (sizeof(samples) / sizeof(samples[0]))];
+        lines.push_back(StringType(sample.begin(), sample.end()));
+    }
+
+    return lines;
+}
+
+
+template<typename StringType>
+static void compareTrim(const char *name, bool isQuick)
+{
+    typedef typename StringType::value_type CharType;
+
+    const std::vector<StringType> lines = generateLines<StringType>(isQuick ? 20 : 1000);
+    size_t totalSize = 0;
+
+    const Tests::Measurement baseline = Tests::measure(isQuick ? 1 : 1000, [&]()
+    {
+        for (const auto &line : lines)
+        {
+            totalSize += Tests::BaselineConfigFile<StringType>::trim(line).size();
+        }
+    });
+
+    const Tests::Measurement current = Tests::measure(isQuick ? 1 : 100000, [&]()
+    {
+        for (const auto &line : lines)
+        {
+            totalSize += TextUtils::trim(std::basic_string_view<CharType>(line)).size();
+        }
+    });
+
+    Tests::printComparison(name, std::to_string(lines.size()) + " lines", baseline, current);
+
+    if (totalSize == 0)
+    {
+        printf("Nothing trimmed\n");
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool isQuick = Tests::isQuickRun(argc, argv);
+
+    compareTrim<std::string>("trim<string>", isQuick);
+    compareTrim<std::wstring>("trim<wstring>", isQuick);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "TestRunner.h"
+#include "../utils/WriteBackScheduler.h"
+
+
+using namespace Loader;
+
+
+TEST_CASE(burstIsWrittenOnce)
+{
+    int writes = 0;
+    WriteBackScheduler scheduler(100, [&writes]() { writes++; return true; });
+
+    scheduler.markDirty();
+    scheduler.markDirty();
+    scheduler.markDirty();
+    CHECK(scheduler.flush());
+    CHECK(!scheduler.isDirty());
+
+    CHECK(writes == 1);
+    CHECK(scheduler.getRequestedWrites() == 3);
+    CHECK(scheduler.getPerformedWrites() == 1);
+    CHECK(scheduler.getCoalescedWrites() == 2);
+}
+
+
+TEST_CASE(separateWindowsAreNotCoalesced)
+{
+    WriteBackScheduler scheduler(100, []() { return true; });
+
+    scheduler.markDirty();
+    CHECK(scheduler.flush());
+    scheduler.markDirty();
+    CHECK(scheduler.flush());
+    CHECK(scheduler.flush()); // Nothing to write.
+
+    CHECK(scheduler.getPerformedWrites() == 2);
+    CHECK(scheduler.getCoalescedWrites() == 0);
+}
+
+
+TEST_CASE(failedAndPendingWritesAreNotCoalesced)
+{
+    bool isWritable = false;
+    WriteBackScheduler scheduler(100, [&isWritable]() { return isWritable; });
+
+    scheduler.markDirty();
+    CHECK(!scheduler.flush());
+    CHECK(scheduler.isDirty());
+    CHECK(scheduler.getPerformedWrites() == 0);
+    CHECK(scheduler.getCoalescedWrites() == 0);
+
+    // Failed write is still pending, the next request joins it.
+    scheduler.markDirty();
+    CHECK(scheduler.getCoalescedWrites() == 1);
+
+    isWritable = true;
+    CHECK(scheduler.flush());
+    CHECK(scheduler.getPerformedWrites() == 1);
+
+    scheduler.markDirty(); // Pending, not written yet.
+    CHECK(scheduler.getRequestedWrites() == 3);
+    CHECK(scheduler.getCoalescedWrites() == 1);
+}
+
+
+TEST_MAIN()
@@ -1,372 +1,1003 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "ConfigFile.h"
-#include "FileSystem.h"
-#include <locale>
-#include <fstream>
-
-
-namespace Loader
-{
-
-const size_t kMaxConfigFileSizeBytes = 256 * 1024;
-
-template<>
-const std::string ConfigFile<std::string>::kEmptyString = "";
-
-template<>
-const std::wstring ConfigFile<std::wstring>::kEmptyString = L"";
-
-template<>
-const std::string ConfigFile<std::string>::kSectionStart = "[";
-
-template<>
-const std::wstring ConfigFile<std::wstring>::kSectionStart = L"[";
-
-template<>
-const std::string ConfigFile<std::string>::kSectionEnd = "]";
-
-template<>
-const std::wstring ConfigFile<std::wstring>::kSectionEnd = L"]";
-
-template<>
-const std::string ConfigFile<std::string>::kEqual = "=";
-
-template<>
-const std::wstring ConfigFile<std::wstring>::kEqual = L"=";
-
-
-template<typename StrigType>
-static std::locale getLocale()
-{
-    return std::locale::classic();
-}
-
-
-template<>
-std::locale getLocale<std::wstring>()
-{
-    std::ios::sync_with_stdio(false);
-    return std::locale("en_US.UTF-8");
-}
-
-template<typename StringType>
-static bool isNonSpace(typename StringType::value_type ch)
-{
-    return !std::isspace<typename StringType::value_type>(ch, getLocale<StringType>());
-};
-
-
-template<typename StringType>
-static StringType& trim(StringType &str)
-{
-    str.erase(str.begin(), std::find_if(str.begin(), str.end(), isNonSpace<StringType>));
-    str.erase(std::find_if(str.rbegin(), str.rend(), isNonSpace<StringType>).base(), str.end());
-
-    return str;
-}
-
-
-template<typename StringType>
-static StringType trim(const StringType &str)
-{
-    StringType strCopy = str;
-    return trim(strCopy);
-}
-
-
-template<typename StringType>
-ConfigFile<StringType>::ConfigFile()
-    : hasChanges(false)
-{}
-
-
-template<typename StringType>
-ConfigFile<StringType>::ConfigFile(const std::wstring &path)
-    : path(path)
-    , hasChanges(false)
-{
-    reload();
-}
-
-
-template<typename StringType>
-ConfigFile<StringType>::~ConfigFile()
-{
-    save();
-}
-
-
-template<typename StringType>
-const std::wstring& ConfigFile<StringType>::getPath() const
-{
-    return path;
-}
-
-
-template<typename StringType>
-std::vector<StringType> ConfigFile<StringType>::listSections() const
-{
-    std::vector<StringType> sections;
-    sections.reserve(config.size());
-
-    for (const auto &it : config)
-    {
-        sections.push_back(it.first);
-    }
-
-    return sections;
-}
-
-
-template<typename StringType>
-std::vector<StringType> ConfigFile<StringType>::listKeys(const StringType &section) const
-{
-    std::vector<StringType> keys;
-
-    const auto sectionIt = config.find(section);
-    if (sectionIt != config.end())
-    {
-        keys.reserve(sectionIt->second.size());
-        for (const auto &it : sectionIt->second)
-        {
-            keys.push_back(it.first);
-        }
-    }
-
-    return keys;
-}
-
-
-template<typename StringType>
-const StringType& ConfigFile<StringType>::getValue(const StringType &section, const StringType &key) const
-{
-    const StringType *valuePtr = &kEmptyString;
-
-    const auto sectionIt = config.find(trim(section));
-
-    if (sectionIt != config.end())
-    {
-        const auto keyIt = sectionIt->second.find(trim(key));
-        if (keyIt != sectionIt->second.end())
-        {
-            valuePtr = &keyIt->second;
-        }
-    }
-
-    return *valuePtr;
-}
-
-
-template<typename StringType>
-int32_t ConfigFile<StringType>::getValue(const StringType &section, const StringType &key, int32_t defVal) const
-{
-    const auto strVal = getValue(section, key);
-
-    if (!strVal.empty())
-    {
-        try
-        {
-            return std::stoi(strVal);
-        }
-        catch (...) {}
-    }
-
-    return defVal;
-}
-
-
-template<typename StringType>
-StringType ConfigFile<StringType>::getValue(const StringType &section, const StringType &key, const StringType &defVal) const
-{
-    const auto strVal = getValue(section, key);
-
-    return strVal.empty()
-        ? defVal
-        : strVal;
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::setValue(const StringType &section, const StringType &key, const StringType &value)
-{
-    auto &valueRef = trim(config[trim(section)][trim(key)]);
-    const auto &newValue = trim(value);
-
-    hasChanges = hasChanges || valueRef != newValue;
-
-    valueRef = newValue;
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::setValue(const StringType &section, const StringType &key, int32_t value)
-{
-    setValue(section, key, toString(value));
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::clearValue(const StringType &section, const StringType &key)
-{
-    const auto sectionIt = config.find(trim(section));
-
-    if (sectionIt != config.end())
-    {
-        auto keyIt = sectionIt->second.find(trim(key));
-        if (keyIt != sectionIt->second.end())
-        {
-            hasChanges = hasChanges || !keyIt->second.empty();
-            keyIt->second.clear();
-        }
-    }
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::reload()
-{
-    reload(path);
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::reload(const std::wstring &newPath)
-{
-    path = newPath;
-
-    if (FileSystem::getFileSize(path) < kMaxConfigFileSizeBytes)
-    {
-        std::basic_ifstream<typename StringType::value_type, std::char_traits<typename StringType::value_type>> file(path, std::ios_base::in);
-
-        if (file.is_open())
-        {
-            file.imbue(getLocale<StringType>());
-
-            config.clear();
-
-            StringType section;
-            StringType key;
-            StringType value;
-
-            for (StringType line; std::getline(file, line);)
-            {
-                if (parseLine(line, &section, &key, &value))
-                {
-                    config[section][key] = value;
-                }
-            }
-
-            file.close();
-        }
-    }
-}
-
-
-template<typename StringType>
-bool ConfigFile<StringType>::parseLine(const StringType &line, StringType *inOutsection, StringType *outKey, StringType *outValue) const
-{
-    bool isParsed = false;
-
-    StringType trimmedLine = trim(line);
-
-    if (trimmedLine.size() > 2)
-    {
-        if (trimmedLine.size() > kSectionStart.size() + kSectionEnd.size() &&
-            !trimmedLine.compare(0, kSectionStart.size(), kSectionStart) &&
-            !trimmedLine.compare(trimmedLine.size() - kSectionEnd.size(), kSectionEnd.size(), kSectionEnd))
-        {
-            *inOutsection = trim(trimmedLine.substr(kSectionStart.size(), trimmedLine.size() - kSectionStart.size() - kSectionEnd.size()));
-        }
-        else
-        {
-            const size_t delimPos = trimmedLine.find(kEqual);
-            if (delimPos != std::string::npos)
-            {
-                *outKey = trim(trimmedLine.substr(0, delimPos));
-                *outValue = trim(trimmedLine.substr(delimPos + 1));
-
-                isParsed = !outKey->empty();
-            }
-        }
-    }
-
-    return isParsed;
-}
-
-
-template<typename StringType>
-void ConfigFile<StringType>::save()
-{
-    if (!config.empty() && hasChanges)
-    {
-        std::basic_ofstream<typename StringType::value_type, std::char_traits<typename StringType::value_type>> file(
-            path, std::ios_base::trunc | std::ios_base::out);
-
-        if (file.is_open())
-        {
-            file.imbue(getLocale<StringType>());
-
-            for (const auto &section : config)
-            {
-                if (!section.first.empty())
-                {
-                    file << kSectionStart << section.first << kSectionEnd << std::endl;
-                }
-
-                for (const auto &key : section.second)
-                {
-                    file << key.first << kEqual << key.second << std::endl;
-                }
-            }
-
-            file.close();
-
-            hasChanges = false;
-        }
-    }
-}
-
-
-template<>
-template<typename T>
-std::wstring ConfigFile<std::wstring>::toString(const T &val) const
-{
-    return std::to_wstring(val);
-}
-
-
-template<>
-template<typename T>
-std::string ConfigFile<std::string>::toString(const T &val) const
-{
-    return std::to_string(val);
-}
-
-
-template class ConfigFile<std::string>;
-template class ConfigFile<std::wstring>;
-
-}
-
-
-
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ConfigFile.h"
+#include "FileSystem.h"
+#include "TextEncoding.h"
+#include "TextUtils.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace Loader
+{
+
+const size_t kReadBlockSize = 64 * 1024;                // Bytes of the file.
+const size_t kMaxRetainedSourceSize = 1024 * 1024;      // Characters.
+const size_t kMaxSaveAttempts = 5;
+
+template<>
+const std::string ConfigFile<std::string>::kEmptyString = "";
+
+template<>
+const std::wstring ConfigFile<std::wstring>::kEmptyString = L"";
+
+template<>
+const std::string ConfigFile<std::string>::kSectionStart = "[";
+
+template<>
+const std::wstring ConfigFile<std::wstring>::kSectionStart = L"[";
+
+template<>
+const std::string ConfigFile<std::string>::kSectionEnd = "]";
+
+template<>
+const std::wstring ConfigFile<std::wstring>::kSectionEnd = L"]";
+
+template<>
+const std::string ConfigFile<std::string>::kEqual = "=";
+
+template<>
+const std::wstring ConfigFile<std::wstring>::kEqual = L"=";
+
+template<>
+const std::string ConfigFile<std::string>::kLineBreak = "\r\n";
+
+template<>
+const std::wstring ConfigFile<std::wstring>::kLineBreak = L"\r\n";
+
+template<>
+const std::string::value_type ConfigFile<std::string>::kLineEnd = '\n';
+
+template<>
+const std::wstring::value_type ConfigFile<std::wstring>::kLineEnd = L'\n';
+
+
+template<typename StringType>
+ConfigFile<StringType>::ConfigFile()
+    : durability(FileSystem::WriteDurability::Flush)
+    , layoutMode(ConfigLayoutMode::Preserve)
+    , loadMode(ConfigLoadMode::Eager)
+    , hasChanges(false)
+    , generation(0)
+    , mergedSaves(0)
+    , mergeConflicts(0)
+    , fileInfo()
+    , contentHash(0)
+    , encoding(TextEncoding::Encoding::Utf8)
+    , isSourceRetained(true)
+    , lazyParsedSections(0)
+{}
+
+
+template<typename StringType>
+ConfigFile<StringType>::ConfigFile(const std::wstring &path, ConfigLoadMode loadMode)
+    : path(path)
+    , durability(FileSystem::WriteDurability::Flush)
+    , layoutMode(ConfigLayoutMode::Preserve)
+    , loadMode(loadMode)
+    , hasChanges(false)
+    , generation(0)
+    , mergedSaves(0)
+    , mergeConflicts(0)
+    , fileInfo()
+    , contentHash(0)
+    , encoding(TextEncoding::Encoding::Utf8)
+    , isSourceRetained(true)
+    , lazyParsedSections(0)
+{
+    reload();
+}
+
+
+template<typename StringType>
+ConfigFile<StringType>::~ConfigFile()
+{
+    save();
+}
+
+
+template<typename StringType>
+const std::wstring& ConfigFile<StringType>::getPath() const
+{
+    return path;
+}
+
+
+template<typename StringType>
+const FileSystem::FileInfo& ConfigFile<StringType>::getFileInfo() const
+{
+    return fileInfo;
+}
+
+
+template<typename StringType>
+uint64_t ConfigFile<StringType>::getContentHash() const
+{
+    return contentHash;
+}
+
+
+template<typename StringType>
+typename ConfigFile<StringType>::SectionsRange ConfigFile<StringType>::sections() const
+{
+    ensureAllParsed();
+
+    return config.sections();
+}
+
+
+template<typename StringType>
+typename ConfigFile<StringType>::KeysRange ConfigFile<StringType>::keys(StringViewType section) const
+{
+    section = TextUtils::trim(section);
+    ensureSectionParsed(section);
+
+    return config.keys(section);
+}
+
+
+template<typename StringType>
+const StringType& ConfigFile<StringType>::getValue(StringViewType section, StringViewType key) const
+{
+    section = TextUtils::trim(section);
+    ensureSectionParsed(section);
+
+    const StringType *valuePtr = config.find(section, TextUtils::trim(key));
+
+    return valuePtr != nullptr
+        ? *valuePtr
+        : kEmptyString;
+}
+
+
+template<typename StringType>
+int32_t ConfigFile<StringType>::getValue(StringViewType section, StringViewType key, int32_t defVal) const
+{
+    int32_t value = defVal;
+
+    return TextUtils::parseInt(StringViewType(getValue(section, key)), &value)
+        ? value
+        : defVal;
+}
+
+
+template<typename StringType>
+StringType ConfigFile<StringType>::getValue(StringViewType section, StringViewType key, const StringType &defVal) const
+{
+    const auto &strVal = getValue(section, key);
+
+    return strVal.empty()
+        ? defVal
+        : strVal;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::setValue(StringViewType section, StringViewType key, StringViewType value)
+{
+    section = TextUtils::trim(section);
+    key = TextUtils::trim(key);
+    value = TextUtils::trim(value);
+
+    ensureSectionParsed(section);
+
+    StringType *valuePtr = config.find(section, key);
+    if (valuePtr == nullptr)
+    {
+        valuePtr = &config.insert(section, key);
+        generation++;
+    }
+
+    if (*valuePtr != value)
+    {
+        rememberChange(section, key, *valuePtr);
+        valuePtr->assign(value.data(), value.size());
+        hasChanges = true;
+        generation++;
+    }
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::setValue(StringViewType section, StringViewType key, int32_t value)
+{
+    setValue(section, key, toString(value));
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::clearValue(StringViewType section, StringViewType key)
+{
+    section = TextUtils::trim(section);
+    ensureSectionParsed(section);
+
+    StringType *valuePtr = config.find(section, TextUtils::trim(key));
+
+    if (valuePtr != nullptr && !valuePtr->empty())
+    {
+        rememberChange(section, TextUtils::trim(key), *valuePtr);
+        valuePtr->clear();
+        hasChanges = true;
+        generation++;
+    }
+}
+
+
+template<typename StringType>
+const StringType* ConfigFile<StringType>::findValue(StringViewType section, StringViewType key) const
+{
+    section = TextUtils::trim(section);
+    ensureSectionParsed(section);
+
+    return config.find(section, TextUtils::trim(key));
+}
+
+
+template<typename StringType>
+std::vector<StringType> ConfigFile<StringType>::listSections() const
+{
+    const auto range = sections();
+    return std::vector<StringType>(range.begin(), range.end());
+}
+
+
+template<typename StringType>
+std::vector<StringType> ConfigFile<StringType>::listKeys(StringViewType section) const
+{
+    const auto range = keys(section);
+    return std::vector<StringType>(range.begin(), range.end());
+}
+
+
+template<typename StringType>
+bool ConfigFile<StringType>::reload()
+{
+    return reload(path);
+}
+
+
+template<typename StringType>
+bool ConfigFile<StringType>::reload(const std::wstring &newPath)
+{
+    path = newPath;
+
+    // State is taken before reading: if the file changes in between, next save merges once more instead of losing changes.
+    FileSystem::FileInfo newFileInfo = {};
+    FileSystem::getFileInfo(path, &newFileInfo);
+
+    const FileSystem::MappedFile file(path);
+    const bool isLoaded = file.isOpened() || !FileSystem::isFileExist(path);
+
+    if (isLoaded)
+    {
+        fileInfo = newFileInfo;
+        contentHash = file.isMapped() ? FileSystem::getContentHash(file.getData(), file.getSize()) : 0;
+    }
+
+    // Empty file can not be mapped, but it is a valid empty config.
+    if (file.isOpened())
+    {
+        hasChanges = false;
+        changedKeys.clear();
+        config.clear();
+        source.clear();
+        valueSpans.clear();
+        sectionEnds.clear();
+        unparsedSections.clear();
+        lazyParsedSections = 0;
+        isSourceRetained = true;
+        generation++;
+
+        size_t bomSize = 0;
+        encoding = TextEncoding::detect(file.getData(), file.getSize(), &bomSize);
+
+        const char *data = file.getData() + bomSize;
+        const size_t size = file.getSize() - bomSize;
+
+        if (loadMode == ConfigLoadMode::Lazy)
+        {
+            TextEncoding::decode(data, size, encoding, &source);
+            indexSections();
+        }
+        else
+        {
+            parseBlocks(data, size);
+        }
+    }
+
+    return isLoaded;
+}
+
+
+template<typename StringType>
+uint64_t ConfigFile<StringType>::getGeneration() const
+{
+    return generation;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::parseBlocks(const char *data, size_t size)
+{
+    // File content is decoded and parsed by blocks of complete lines, so only one block of text is kept in memory.
+    // Line break byte never occurs inside of a multibyte UTF-8 sequence, UTF-16 is split at whole code units.
+    const bool isUtf16 = encoding == TextEncoding::Encoding::Utf16LE || encoding == TextEncoding::Encoding::Utf16BE;
+    const size_t unitSize = isUtf16 ? 2 : 1;
+    const size_t lowByte = encoding == TextEncoding::Encoding::Utf16BE ? 1 : 0;
+
+    const auto isLineEnd = [data, isUtf16, lowByte](size_t unit)
+    {
+        return isUtf16
+            ? data[unit + lowByte] == '\n' && data[unit + 1 - lowByte] == 0
+            : data[unit] == '\n';
+    };
+
+    StringType block;
+    StringType section;
+    size_t textOffset = 0;
+    size_t blockStart = 0;
+
+    while (blockStart < size)
+    {
+        size_t blockEnd = (std::min)(size, blockStart + kReadBlockSize);
+
+        if (blockEnd < size)
+        {
+            blockEnd -= (blockEnd - blockStart) % unitSize;
+
+            // Block ends after its last line break, a line longer than a block is taken whole.
+            size_t lineEnd = blockEnd;
+            while (lineEnd > blockStart && !isLineEnd(lineEnd - unitSize))
+            {
+                lineEnd -= unitSize;
+            }
+
+            if (lineEnd == blockStart)
+            {
+                lineEnd = blockEnd;
+                while (lineEnd + unitSize <= size && !isLineEnd(lineEnd))
+                {
+                    lineEnd += unitSize;
+                }
+
+                lineEnd = (std::min)(lineEnd + unitSize, size);
+            }
+
+            blockEnd = lineEnd;
+        }
+
+        block.clear();
+        TextEncoding::decode(data + blockStart, blockEnd - blockStart, encoding, &block);
+
+        if (isSourceRetained && source.size() + block.size() > kMaxRetainedSourceSize)
+        {
+            dropSource();
+        }
+
+        if (isSourceRetained)
+        {
+            source.append(block);
+        }
+
+        parseLines(block, textOffset, false, &section);
+
+        textOffset += block.size();
+        blockStart = blockEnd;
+    }
+
+    config.commit();
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::parseLines(StringViewType text, size_t textOffset, bool isReindex, StringType *inOutSection) const
+{
+    const typename StringType::value_type *textStart = text.data();
+    StringViewType section = *inOutSection;
+    StringViewType key;
+    StringViewType value;
+
+    while (!text.empty())
+    {
+        const size_t lineEnd = text.find(kLineEnd);
+        const StringViewType line = text.substr(0, lineEnd);
+        const StringViewType prevSection = section;
+
+        text.remove_prefix(lineEnd != StringViewType::npos ? lineEnd + 1 : text.size());
+
+        const size_t nextLineOffset = textOffset + (size_t)(text.data() - textStart);
+
+        if (parseLine(line, &section, &key, &value))
+        {
+            StringType *valuePtr = isReindex
+                ? config.find(section, key)
+                : &config.append(section, key, value);
+
+            if (valuePtr != nullptr && isSourceRetained)
+            {
+                valueSpans[valuePtr] = ValueSpan{textOffset + (size_t)(value.data() - textStart), value.size()};
+            }
+        }
+        else if (section.data() == prevSection.data())
+        {
+            continue; // Neither key nor section header.
+        }
+        else
+        {
+            // Section name is copied, because text may not outlive the next call.
+            inOutSection->assign(section.data(), section.size());
+            section = *inOutSection;
+        }
+
+        if (isSourceRetained)
+        {
+            const auto it = sectionEnds.find(section);
+            if (it != sectionEnds.end())
+            {
+                it->second = (std::max)(it->second, nextLineOffset); // Lazily parsed sections may come in any order.
+            }
+            else
+            {
+                sectionEnds.emplace(StringType(section), nextLineOffset);
+            }
+        }
+    }
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::indexSections()
+{
+    const StringViewType text = source;
+    StringViewType section;
+    StringViewType key;
+    StringViewType value;
+    size_t bodyStart = 0;
+
+    const auto addBody = [this](StringViewType name, size_t start, size_t end)
+    {
+        if (end > start)
+        {
+            auto it = unparsedSections.find(name);
+            if (it == unparsedSections.end())
+            {
+                it = unparsedSections.emplace(StringType(name), std::vector<TextRange>()).first;
+            }
+
+            it->second.push_back(TextRange{start, end - start});
+        }
+    };
+
+    for (size_t lineStart = 0; lineStart < text.size();)
+    {
+        const size_t lineEnd = text.find(kLineEnd, lineStart);
+        const size_t nextLineStart = lineEnd != StringViewType::npos ? lineEnd + 1 : text.size();
+        const StringViewType line = text.substr(lineStart, nextLineStart - lineStart);
+        const StringViewType trimmedLine = TextUtils::trimLeft(line);
+
+        // Only section headers are recognized here, other lines are parsed on access.
+        if (!trimmedLine.empty() && trimmedLine.front() == kSectionStart.front())
+        {
+            StringViewType newSection = section;
+            parseLine(line, &newSection, &key, &value);
+
+            if (newSection.data() != section.data())
+            {
+                addBody(section, bodyStart, lineStart);
+
+                const auto it = sectionEnds.find(newSection);
+                if (it != sectionEnds.end())
+                {
+                    it->second = nextLineStart;
+                }
+                else
+                {
+                    sectionEnds.emplace(StringType(newSection), nextLineStart);
+                }
+
+                section = newSection;
+                bodyStart = nextLineStart;
+            }
+        }
+
+        lineStart = nextLineStart;
+    }
+
+    addBody(section, bodyStart, text.size());
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::ensureSectionParsed(StringViewType section) const
+{
+    if (!unparsedSections.empty())
+    {
+        const auto it = unparsedSections.find(section);
+        if (it != unparsedSections.end())
+        {
+            StringType sectionName = it->first;
+
+            for (const auto &range : it->second)
+            {
+                parseLines(StringViewType(source).substr(range.offset, range.length), range.offset, false, &sectionName);
+            }
+
+            unparsedSections.erase(it);
+            config.commit();
+            lazyParsedSections++;
+        }
+    }
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::ensureAllParsed() const
+{
+    while (!unparsedSections.empty())
+    {
+        ensureSectionParsed(unparsedSections.begin()->first);
+    }
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::reindex()
+{
+    StringType section;
+    const auto prevUnparsedSections = std::move(unparsedSections);
+
+    valueSpans.clear();
+    sectionEnds.clear();
+    unparsedSections.clear();
+
+    // Bodies of not parsed sections are found again in the new text, other sections are parsed already.
+    if (!prevUnparsedSections.empty())
+    {
+        indexSections();
+
+        for (auto it = unparsedSections.begin(); it != unparsedSections.end();)
+        {
+            it = prevUnparsedSections.count(it->first) != 0 ? std::next(it) : unparsedSections.erase(it);
+        }
+    }
+
+    parseLines(source, 0, true, &section);
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::shiftLayout(const std::vector<Patch> &patches)
+{
+    // Patches are sorted by offset and replace values only, so every position moves
+    // by the total size change of the patches before it.
+    std::vector<std::ptrdiff_t> shifts;
+    shifts.reserve(patches.size() + 1);
+    shifts.push_back(0);
+
+    for (const auto &item : patches)
+    {
+        shifts.push_back(shifts.back() + static_cast<std::ptrdiff_t>(item.text.size()) - static_cast<std::ptrdiff_t>(item.length));
+    }
+
+    const auto findFirstAfter = [&patches](size_t offset)
+    {
+        return static_cast<size_t>(std::lower_bound(patches.begin(), patches.end(), offset, [](const Patch &item, size_t value)
+        {
+            return item.offset < value;
+        }) - patches.begin());
+    };
+
+    if (!patches.empty())
+    {
+        for (auto &span : valueSpans)
+        {
+            const size_t index = findFirstAfter(span.second.offset);
+
+            if (index < patches.size() && patches[index].offset == span.second.offset)
+            {
+                span.second.length = patches[index].text.size();
+            }
+
+            span.second.offset += shifts[index];
+        }
+
+        for (auto &sectionEnd : sectionEnds)
+        {
+            sectionEnd.second += shifts[findFirstAfter(sectionEnd.second)];
+        }
+
+        // Values of not parsed sections are never patched, their bodies only move.
+        for (auto &unparsedSection : unparsedSections)
+        {
+            for (auto &range : unparsedSection.second)
+            {
+                range.offset += shifts[findFirstAfter(range.offset)];
+            }
+        }
+    }
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::dropSource()
+{
+    isSourceRetained = false;
+
+    source.clear();
+    source.shrink_to_fit();
+    valueSpans.clear();
+    sectionEnds.clear();
+}
+
+
+template<typename StringType>
+bool ConfigFile<StringType>::parseLine(StringViewType line, StringViewType *inOutSection, StringViewType *outKey, StringViewType *outValue) const
+{
+    bool isParsed = false;
+
+    const StringViewType trimmedLine = TextUtils::trim(line);
+
+    if (trimmedLine.size() > 2 && trimmedLine.front() != ';' && trimmedLine.front() != '#')
+    {
+        if (trimmedLine.size() > kSectionStart.size() + kSectionEnd.size() &&
+            !trimmedLine.compare(0, kSectionStart.size(), kSectionStart) &&
+            !trimmedLine.compare(trimmedLine.size() - kSectionEnd.size(), kSectionEnd.size(), kSectionEnd))
+        {
+            *inOutSection = TextUtils::trim(trimmedLine.substr(kSectionStart.size(), trimmedLine.size() - kSectionStart.size() - kSectionEnd.size()));
+        }
+        else
+        {
+            const size_t delimPos = trimmedLine.find(kEqual);
+            if (delimPos != StringViewType::npos)
+            {
+                *outKey = TextUtils::trim(trimmedLine.substr(0, delimPos));
+                *outValue = TextUtils::trim(trimmedLine.substr(delimPos + 1));
+
+                isParsed = !outKey->empty();
+            }
+        }
+    }
+
+    return isParsed;
+}
+
+
+template<typename StringType>
+bool ConfigFile<StringType>::save()
+{
+    bool isSaved = true;
+
+    if (!config.empty() && hasChanges && !path.empty())
+    {
+        FileSystem::WriteResult result = FileSystem::WriteResult::Conflict;
+
+        for (size_t attempt = 0; attempt < kMaxSaveAttempts && result == FileSystem::WriteResult::Conflict; ++attempt)
+        {
+            if (attempt > 0)
+            {
+                mergeWithFile();
+            }
+
+            if (!hasChanges)
+            {
+                result = FileSystem::WriteResult::Written; // File already has all local changes.
+            }
+            else
+            {
+                // Patched text keeps sections that were not parsed as they are, rebuilt one takes all from config.
+                const bool isPatched = layoutMode == ConfigLayoutMode::Preserve && isSourceRetained;
+                if (!isPatched)
+                {
+                    ensureAllParsed();
+                }
+
+                std::vector<Patch> patches;
+                bool hasNewKeys = true;
+                StringType text = isPatched ? patch(&patches, &hasNewKeys) : serialize();
+
+                // File keeps encoding and BOM it was loaded with, UTF-8 text without BOM is written as is.
+                std::string bytes;
+                const char *data = reinterpret_cast<const char*>(text.data());
+                size_t size = text.size();
+
+                if (!std::is_same_v<typename StringType::value_type, char> || encoding != TextEncoding::Encoding::Utf8)
+                {
+                    TextEncoding::encode(text, encoding, &bytes);
+                    data = bytes.data();
+                    size = bytes.size();
+                }
+
+                FileSystem::FileInfo newFileInfo = {};
+                result = FileSystem::writeFileIfUnchanged(path, data, size, durability, fileInfo, &newFileInfo);
+
+                if (result == FileSystem::WriteResult::Written)
+                {
+                    fileInfo = newFileInfo;
+                    contentHash = size != 0 ? FileSystem::getContentHash(data, size) : 0;
+                    hasChanges = false;
+                    changedKeys.clear();
+
+                    if (text.size() <= kMaxRetainedSourceSize)
+                    {
+                        source = std::move(text);
+
+                        // Changed values only move the known layout, new keys have no positions yet.
+                        if (isSourceRetained && !hasNewKeys)
+                        {
+                            shiftLayout(patches);
+                        }
+                        else
+                        {
+                            isSourceRetained = true;
+                            reindex();
+                        }
+                    }
+                    else
+                    {
+                        // Bodies of not parsed sections are ranges of the text being dropped.
+                        ensureAllParsed();
+                        dropSource();
+                    }
+                }
+            }
+        }
+
+        isSaved = result == FileSystem::WriteResult::Written;
+    }
+
+    return isSaved;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::rememberChange(StringViewType section, StringViewType key, const StringType &oldValue)
+{
+    // Only the value loaded from the file matters for merging, later changes keep it.
+    changedKeys.emplace(std::make_pair(StringType(section), StringType(key)), oldValue);
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::mergeWithFile()
+{
+    struct LocalChange
+    {
+        StringType section;
+        StringType key;
+        StringType baseValue;
+        StringType localValue;
+    };
+
+    std::vector<LocalChange> localChanges;
+    localChanges.reserve(changedKeys.size());
+
+    for (const auto &changedKey : changedKeys)
+    {
+        const StringType *localValue = config.find(changedKey.first.first, changedKey.first.second);
+
+        localChanges.push_back(LocalChange{changedKey.first.first, changedKey.first.second, changedKey.second,
+            localValue != nullptr ? *localValue : kEmptyString});
+    }
+
+    // Three way merge: keys not changed locally take the new file values, local changes are applied on top.
+    // Missing file keeps the current content, it is written again as a whole.
+    reload();
+
+    for (const auto &change : localChanges)
+    {
+        const StringType *fileValue = findValue(change.section, change.key);
+
+        if (fileValue != nullptr && *fileValue != change.baseValue && *fileValue != change.localValue)
+        {
+            mergeConflicts++;
+        }
+
+        setValue(StringViewType(change.section), StringViewType(change.key), StringViewType(change.localValue));
+    }
+
+    mergedSaves++;
+}
+
+
+template<typename StringType>
+bool ConfigFile<StringType>::hasUnsavedChanges() const
+{
+    return hasChanges;
+}
+
+
+template<typename StringType>
+uint64_t ConfigFile<StringType>::getMergedSaves() const
+{
+    return mergedSaves;
+}
+
+
+template<typename StringType>
+uint64_t ConfigFile<StringType>::getMergeConflicts() const
+{
+    return mergeConflicts;
+}
+
+
+template<typename StringType>
+uint64_t ConfigFile<StringType>::getLazyParsedSections() const
+{
+    return lazyParsedSections;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::setWriteDurability(FileSystem::WriteDurability newDurability)
+{
+    durability = newDurability;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::setLayoutMode(ConfigLayoutMode newLayoutMode)
+{
+    layoutMode = newLayoutMode;
+}
+
+
+template<typename StringType>
+void ConfigFile<StringType>::setLoadMode(ConfigLoadMode newLoadMode)
+{
+    loadMode = newLoadMode;
+}
+
+
+template<typename StringType>
+StringType ConfigFile<StringType>::serialize() const
+{
+    StringType text;
+
+    for (const auto &section : config.sections())
+    {
+        if (!section.empty())
+        {
+            text.append(kSectionStart).append(section).append(kSectionEnd).append(kLineBreak);
+        }
+
+        for (const auto &key : config.keys(section))
+        {
+            text.append(key).append(kEqual).append(*config.find(section, key)).append(kLineBreak);
+        }
+    }
+
+    return text;
+}
+
+
+template<typename StringType>
+StringType ConfigFile<StringType>::patch(std::vector<Patch> *outPatches, bool *outHasNewKeys) const
+{
+    // Text inserted at the end of the last line, which has no line break.
+    const bool isSourceTerminated = source.empty() || source.back() == kLineEnd;
+    std::vector<Patch> &patches = *outPatches;
+    StringType newSections;
+
+    *outHasNewKeys = false;
+
+    for (const auto &section : config.sections())
+    {
+        StringType newKeys;
+
+        for (const auto &key : config.keys(section))
+        {
+            const StringType &value = *config.find(section, key);
+            const auto span = valueSpans.find(&value);
+
+            if (span == valueSpans.end())
+            {
+                newKeys.append(key).append(kEqual).append(value).append(kLineBreak);
+            }
+            else if (source.compare(span->second.offset, span->second.length, value) != 0)
+            {
+                patches.push_back(Patch{span->second.offset, span->second.length, value});
+            }
+        }
+
+        if (!newKeys.empty())
+        {
+            *outHasNewKeys = true;
+
+            const auto sectionEnd = sectionEnds.find(StringViewType(section));
+
+            if (sectionEnd != sectionEnds.end() || section.empty())
+            {
+                const size_t offset = sectionEnd != sectionEnds.end() ? sectionEnd->second : 0;
+
+                patches.push_back(Patch{offset, 0, offset == source.size() && !isSourceTerminated
+                    ? kLineBreak + newKeys
+                    : std::move(newKeys)});
+            }
+            else
+            {
+                newSections.append(kSectionStart).append(section).append(kSectionEnd).append(kLineBreak).append(newKeys);
+            }
+        }
+    }
+
+    std::stable_sort(patches.begin(), patches.end(), [](const Patch &left, const Patch &right)
+    {
+        return left.offset < right.offset;
+    });
+
+    size_t textSize = source.size() + newSections.size() + kLineBreak.size();
+    for (const auto &item : patches)
+    {
+        textSize += item.text.size();
+    }
+
+    StringType text;
+    text.reserve(textSize);
+
+    size_t position = 0;
+    for (const auto &item : patches)
+    {
+        text.append(source, position, item.offset - position).append(item.text);
+        position = item.offset + item.length;
+    }
+
+    text.append(source, position, StringType::npos);
+
+    if (!newSections.empty())
+    {
+        if (!text.empty() && text.back() != kLineEnd)
+        {
+            text.append(kLineBreak);
+        }
+
+        text.append(newSections);
+    }
+
+    return text;
+}
+
+
+template<>
+template<typename T>
+std::wstring ConfigFile<std::wstring>::toString(const T &val) const
+{
+    return std::to_wstring(val);
+}
+
+
+template<>
+template<typename T>
+std::string ConfigFile<std::string>::toString(const T &val) const
+{
+    return std::to_string(val);
+}
+
+
+template class ConfigFile<std::string>;
+template class ConfigFile<std::wstring>;
+
+}
+
+
+
+
+
@@ -1,82 +1,194 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#ifndef __UTILS_CONFIG_FILE_H__
-#define __UTILS_CONFIG_FILE_H__
-
-
-#include <string>
-#include <map>
-#include <vector>
-
-
-namespace Loader
-{
-
-template<typename StringType>
-class ConfigFile
-{
-public:
-    ConfigFile();
-    explicit ConfigFile(const std::wstring &path);
-    virtual ~ConfigFile();
-
-    const std::wstring &getPath() const;
-    std::vector<StringType> listSections() const;
-    std::vector<StringType> listKeys(const StringType &section) const;
-
-    const StringType& getValue(const StringType &section, const StringType &key) const;
-    int32_t getValue(const StringType &section, const StringType &key, int32_t defVal) const;
-    StringType getValue(const StringType &section, const StringType &key, const StringType &defVal) const;
-    void setValue(const StringType &section, const StringType &key, const StringType &value);
-    void setValue(const StringType &section, const StringType &key, int32_t value);
-    void clearValue(const StringType &section, const StringType &key);
-
-    void reload(const std::wstring &newPath);
-    void reload();
-    void save();
-
-private:
-    bool parseLine(const StringType &line, StringType *inOutsection, StringType *outKey, StringType *outValue) const;
-
-    template<typename T>
-    StringType toString(const T &val) const;
-
-private:
-    std::wstring path;
-    std::map<StringType, std::map<StringType, StringType>> config;
-    bool hasChanges;
-
-    static const StringType kEmptyString;
-    static const StringType kSectionStart;
-    static const StringType kSectionEnd;
-    static const StringType kEqual;
-
-};
-
-
-}
-
-
-#endif
-
-
-
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_CONFIG_FILE_H__
+#define __UTILS_CONFIG_FILE_H__
+
+
+#include "ConfigStorage.h"
+#include "FileSystem.h"
+#include "TextEncoding.h"
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Loader
+{
+
+enum class ConfigLayoutMode
+{
+    Preserve, // Keep comments, blank lines and keys order of the loaded file, patch changed values only.
+    Rebuild   // Write sorted sections and keys, drop everything else.
+};
+
+
+enum class ConfigLoadMode
+{
+    Eager, // Parse whole file on load.
+    Lazy   // Only index sections on load, parse keys of a section on its first access.
+};
+
+
+template<typename StringType>
+class ConfigFile
+{
+public:
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+    typedef typename ConfigStorage<StringType>::SectionsRange SectionsRange;
+    typedef typename ConfigStorage<StringType>::KeysRange KeysRange;
+
+    ConfigFile();
+    explicit ConfigFile(const std::wstring &path, ConfigLoadMode loadMode = ConfigLoadMode::Eager);
+    virtual ~ConfigFile();
+
+    const std::wstring &getPath() const;
+    const FileSystem::FileInfo &getFileInfo() const; // File state at last load or save.
+    // 'FileSystem::getContentHash' of the file bytes at last load or save, zero if the file was missing or empty.
+    uint64_t getContentHash() const;
+
+    // Lookups by string views do not allocate memory, except the first access to a section in lazy mode.
+    // Strings and literals are passed as views too: overloads for 'const StringType&' would be ambiguous with them.
+    // Listing sections parses all of them.
+    SectionsRange sections() const;
+    KeysRange keys(StringViewType section) const;
+    const StringType& getValue(StringViewType section, StringViewType key) const;
+    int32_t getValue(StringViewType section, StringViewType key, int32_t defVal) const;
+    StringType getValue(StringViewType section, StringViewType key, const StringType &defVal) const;
+    void setValue(StringViewType section, StringViewType key, StringViewType value);
+    void setValue(StringViewType section, StringViewType key, int32_t value);
+    void clearValue(StringViewType section, StringViewType key);
+    // Returns null if the key is missing, unlike 'getValue' that can not tell it from an empty value.
+    const StringType* findValue(StringViewType section, StringViewType key) const;
+
+    std::vector<StringType> listSections() const;
+    std::vector<StringType> listKeys(StringViewType section) const;
+
+    // Returns false if the file exists, but can not be read (e.g. it is locked by a writer):
+    // loaded values and file state are kept then, so the next change of the file is loaded again.
+    // Missing file also keeps loaded values, it is a valid empty config for a new instance.
+    bool reload(const std::wstring &newPath);
+    bool reload();
+    // Incremented whenever a value is added or changed, including reloads.
+    uint64_t getGeneration() const;
+
+    // Serializes config into one buffer and atomically replaces the file with it.
+    // Returns false only if there were unsaved changes and writing them failed.
+    // Config without path is kept in memory only and is never written.
+    // If the file was changed by someone else since it was loaded or saved, it is reloaded and local changes
+    // are merged into it key by key, then writing is retried. Keys changed on both sides keep the local value.
+    // In lazy mode sections that were not accessed are written from the loaded text and stay not parsed.
+    bool save();
+    bool hasUnsavedChanges() const;
+    uint64_t getMergedSaves() const;   // Saves that had to merge changes made by someone else.
+    uint64_t getMergeConflicts() const; // Keys changed both locally and in the file, local value was kept.
+    uint64_t getLazyParsedSections() const; // Sections parsed on first access since the last load in lazy mode.
+    void setWriteDurability(FileSystem::WriteDurability newDurability);
+    void setLayoutMode(ConfigLayoutMode newLayoutMode);
+    void setLoadMode(ConfigLoadMode newLoadMode); // Applied on the next reload.
+
+private:
+    struct ValueSpan
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    struct TextRange
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    struct Patch
+    {
+        size_t offset;
+        size_t length;
+        StringType text;
+    };
+
+    // Parses complete lines of text starting at 'textOffset' of the whole file.
+    // Loads values into config if 'isReindex' is false, otherwise only rebuilds layout
+    // of the text for values already stored in config. Current section is carried between calls.
+    void parseLines(StringViewType text, size_t textOffset, bool isReindex, StringType *inOutSection) const;
+
+    // Streaming parser for the eager mode.
+    void parseBlocks(const char *data, size_t size);
+    void indexSections();
+    void ensureSectionParsed(StringViewType section) const;
+    void ensureAllParsed() const;
+    void reindex();
+    void shiftLayout(const std::vector<Patch> &patches);
+    void rememberChange(StringViewType section, StringViewType key, const StringType &oldValue);
+    void mergeWithFile();
+    void dropSource();
+    StringType serialize() const;
+    StringType patch(std::vector<Patch> *outPatches, bool *outHasNewKeys) const;
+    bool parseLine(StringViewType line, StringViewType *inOutSection, StringViewType *outKey, StringViewType *outValue) const;
+
+    template<typename T>
+    StringType toString(const T &val) const;
+
+private:
+    std::wstring path;
+    mutable ConfigStorage<StringType> config; // Filled on first access to a section in lazy mode.
+    FileSystem::WriteDurability durability;
+    ConfigLayoutMode layoutMode;
+    ConfigLoadMode loadMode;
+    bool hasChanges;
+    uint64_t generation;
+    uint64_t mergedSaves;
+    uint64_t mergeConflicts;
+    FileSystem::FileInfo fileInfo; // File state at last load or save, zero if file was missing.
+    uint64_t contentHash;
+    std::map<std::pair<StringType, StringType>, StringType> changedKeys; // <section, key> -> value before the first change.
+    TextEncoding::Encoding encoding; // Detected on load, kept on save.
+
+    // Layout of the file content: decoded text, positions of values in it and
+    // positions where new keys of every section should be inserted.
+    // Text of big files is not retained in eager mode, such files are always rebuilt on save.
+    // Lazy mode always retains the text: bodies of not parsed sections are ranges of it.
+    StringType source;
+    bool isSourceRetained;
+    mutable std::unordered_map<const StringType*, ValueSpan> valueSpans;
+    mutable std::map<StringType, size_t, std::less<>> sectionEnds;
+    mutable std::map<StringType, std::vector<TextRange>, std::less<>> unparsedSections;
+    mutable uint64_t lazyParsedSections;
+
+    static const StringType kEmptyString;
+    static const StringType kSectionStart;
+    static const StringType kSectionEnd;
+    static const StringType kEqual;
+    static const StringType kLineBreak;
+    static const typename StringType::value_type kLineEnd;
+
+};
+
+
+}
+
+
+#endif
+
+
+
+
+
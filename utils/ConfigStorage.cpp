@@ -0,0 +1,258 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ConfigStorage.h"
+#include <algorithm>
+
+
+namespace Loader
+{
+
+
+template<typename StringType>
+ConfigStorage<StringType>::ConfigStorage()
+{}
+
+
+template<typename StringType>
+bool ConfigStorage<StringType>::empty() const
+{
+    return keysTable.empty() && pendingKeys.empty();
+}
+
+
+template<typename StringType>
+void ConfigStorage<StringType>::clear()
+{
+    sectionsTable.clear();
+    keysTable.clear();
+    pendingKeys.clear();
+    namesIndex.clear();
+    namesPool.clear();
+    valuesPool.clear();
+}
+
+
+template<typename StringType>
+typename ConfigStorage<StringType>::SectionsRange ConfigStorage<StringType>::sections() const
+{
+    return SectionsRange(sectionsTable.data(), sectionsTable.size());
+}
+
+
+template<typename StringType>
+typename ConfigStorage<StringType>::KeysRange ConfigStorage<StringType>::keys(StringViewType section) const
+{
+    const Section *sectionPtr = findSection(section);
+
+    return sectionPtr != nullptr
+        ? KeysRange(keysTable.data() + sectionPtr->firstKey, sectionPtr->keysCount)
+        : KeysRange(nullptr, 0);
+}
+
+
+template<typename StringType>
+const typename ConfigStorage<StringType>::Section* ConfigStorage<StringType>::findSection(StringViewType section) const
+{
+    const size_t index = lowerBoundSection(section);
+
+    return index < sectionsTable.size() && *sectionsTable[index].name == section
+        ? &sectionsTable[index]
+        : nullptr;
+}
+
+
+template<typename StringType>
+const typename ConfigStorage<StringType>::Key* ConfigStorage<StringType>::findKey(const Section &section, StringViewType key) const
+{
+    const size_t index = lowerBoundKey(section, key);
+
+    return index < section.firstKey + section.keysCount && *keysTable[index].name == key
+        ? &keysTable[index]
+        : nullptr;
+}
+
+
+template<typename StringType>
+const StringType* ConfigStorage<StringType>::find(StringViewType section, StringViewType key) const
+{
+    const StringType *value = nullptr;
+
+    const Section *sectionPtr = findSection(section);
+    if (sectionPtr != nullptr)
+    {
+        const Key *keyPtr = findKey(*sectionPtr, key);
+        if (keyPtr != nullptr)
+        {
+            value = keyPtr->value;
+        }
+    }
+
+    return value;
+}
+
+
+template<typename StringType>
+StringType* ConfigStorage<StringType>::find(StringViewType section, StringViewType key)
+{
+    return const_cast<StringType*>(static_cast<const ConfigStorage*>(this)->find(section, key));
+}
+
+
+template<typename StringType>
+StringType& ConfigStorage<StringType>::insert(StringViewType section, StringViewType key)
+{
+    commit();
+
+    const size_t sectionIndex = lowerBoundSection(section);
+
+    if (sectionIndex == sectionsTable.size() || *sectionsTable[sectionIndex].name != section)
+    {
+        const uint32_t firstKey = sectionIndex < sectionsTable.size()
+            ? sectionsTable[sectionIndex].firstKey
+            : (uint32_t)keysTable.size();
+
+        sectionsTable.insert(sectionsTable.begin() + sectionIndex, Section{intern(section), firstKey, 0});
+    }
+
+    Section &sectionRef = sectionsTable[sectionIndex];
+    const size_t keyIndex = lowerBoundKey(sectionRef, key);
+
+    if (keyIndex == sectionRef.firstKey + sectionRef.keysCount || *keysTable[keyIndex].name != key)
+    {
+        valuesPool.emplace_back();
+        keysTable.insert(keysTable.begin() + keyIndex, Key{intern(key), &valuesPool.back()});
+
+        sectionRef.keysCount++;
+
+        for (size_t i = sectionIndex + 1; i < sectionsTable.size(); ++i)
+        {
+            sectionsTable[i].firstKey++;
+        }
+    }
+
+    return *keysTable[keyIndex].value;
+}
+
+
+template<typename StringType>
+StringType& ConfigStorage<StringType>::append(StringViewType section, StringViewType key, StringViewType value)
+{
+    valuesPool.emplace_back(value);
+    pendingKeys.push_back(PendingKey{intern(section), intern(key), &valuesPool.back()});
+
+    return valuesPool.back();
+}
+
+
+template<typename StringType>
+void ConfigStorage<StringType>::commit()
+{
+    if (!pendingKeys.empty())
+    {
+        std::vector<PendingKey> allKeys;
+        allKeys.reserve(keysTable.size() + pendingKeys.size());
+
+        for (const auto &section : sectionsTable)
+        {
+            for (uint32_t i = 0; i < section.keysCount; ++i)
+            {
+                const Key &key = keysTable[section.firstKey + i];
+                allKeys.push_back(PendingKey{section.name, key.name, key.value});
+            }
+        }
+
+        allKeys.insert(allKeys.end(), pendingKeys.begin(), pendingKeys.end());
+        pendingKeys.clear();
+
+        // Names are interned, so equal names always have equal pointers.
+        std::stable_sort(allKeys.begin(), allKeys.end(), [](const PendingKey &left, const PendingKey &right)
+        {
+            return left.section != right.section
+                ? *left.section < *right.section
+                : left.name != right.name && *left.name < *right.name;
+        });
+
+        sectionsTable.clear();
+        keysTable.clear();
+        keysTable.reserve(allKeys.size());
+
+        for (size_t i = 0; i < allKeys.size(); ++i)
+        {
+            const PendingKey &key = allKeys[i];
+
+            if (i + 1 < allKeys.size() && allKeys[i + 1].section == key.section && allKeys[i + 1].name == key.name)
+            {
+                continue; // Overridden by the next duplicate.
+            }
+
+            if (sectionsTable.empty() || sectionsTable.back().name != key.section)
+            {
+                sectionsTable.push_back(Section{key.section, (uint32_t)keysTable.size(), 0});
+            }
+
+            keysTable.push_back(Key{key.name, key.value});
+            sectionsTable.back().keysCount++;
+        }
+    }
+}
+
+
+template<typename StringType>
+const StringType* ConfigStorage<StringType>::intern(StringViewType name)
+{
+    const auto it = namesIndex.find(name);
+    if (it != namesIndex.end())
+    {
+        return it->second;
+    }
+
+    namesPool.emplace_back(name);
+    const StringType *interned = &namesPool.back();
+    namesIndex.emplace(StringViewType(*interned), interned);
+
+    return interned;
+}
+
+
+template<typename StringType>
+size_t ConfigStorage<StringType>::lowerBoundSection(StringViewType name) const
+{
+    const auto it = std::lower_bound(sectionsTable.begin(), sectionsTable.end(), name,
+        [](const Section &section, StringViewType value) { return StringViewType(*section.name) < value; });
+
+    return (size_t)(it - sectionsTable.begin());
+}
+
+
+template<typename StringType>
+size_t ConfigStorage<StringType>::lowerBoundKey(const Section &section, StringViewType name) const
+{
+    const auto first = keysTable.begin() + section.firstKey;
+    const auto it = std::lower_bound(first, first + section.keysCount, name,
+        [](const Key &key, StringViewType value) { return StringViewType(*key.name) < value; });
+
+    return (size_t)(it - keysTable.begin());
+}
+
+
+template class ConfigStorage<std::string>;
+template class ConfigStorage<std::wstring>;
+
+}
@@ -0,0 +1,145 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_CONFIG_STORAGE_H__
+#define __UTILS_CONFIG_STORAGE_H__
+
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Loader
+{
+
+// Read only view over the names of config sections or keys, allows to iterate them without copying.
+template<typename EntryType, typename StringType>
+class ConfigNameRange
+{
+public:
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef StringType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const StringType* pointer;
+        typedef const StringType& reference;
+
+        explicit Iterator(const EntryType *entry) : entry(entry) {}
+        const StringType& operator*() const { return *entry->name; }
+        const StringType* operator->() const { return entry->name; }
+        Iterator& operator++() { ++entry; return *this; }
+        bool operator==(const Iterator &other) const { return entry == other.entry; }
+        bool operator!=(const Iterator &other) const { return entry != other.entry; }
+
+    private:
+        const EntryType *entry;
+    };
+
+    ConfigNameRange(const EntryType *first, size_t count) : first(first), count(count) {}
+    Iterator begin() const { return Iterator(first); }
+    Iterator end() const { return Iterator(first + count); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    const EntryType *first;
+    size_t count;
+};
+
+
+// Flat storage of parsed config.
+// Section and key names are interned in a string pool, sections are kept in a sorted table
+// and keys of every section occupy a sorted contiguous range of a single keys table.
+// Values live in a pool with stable addresses, so references to them stay valid until 'clear'.
+template<typename StringType>
+class ConfigStorage
+{
+public:
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+
+    struct Section
+    {
+        const StringType *name;
+        uint32_t firstKey;
+        uint32_t keysCount;
+    };
+
+    struct Key
+    {
+        const StringType *name;
+        StringType *value;
+    };
+
+    typedef ConfigNameRange<Section, StringType> SectionsRange;
+    typedef ConfigNameRange<Key, StringType> KeysRange;
+
+    ConfigStorage();
+    ConfigStorage(const ConfigStorage&) = delete;
+    ConfigStorage &operator=(const ConfigStorage&) = delete;
+
+    bool empty() const;
+    void clear();
+
+    SectionsRange sections() const;
+    KeysRange keys(StringViewType section) const;
+    const Section* findSection(StringViewType section) const;
+    const Key* findKey(const Section &section, StringViewType key) const;
+    const StringType* find(StringViewType section, StringViewType key) const;
+    StringType* find(StringViewType section, StringViewType key);
+    StringType& insert(StringViewType section, StringViewType key);
+
+    // Bulk loading: 'append' adds values in any order without keeping the tables sorted,
+    // 'commit' sorts appended values once. Last appended value wins for duplicated keys.
+    // Reference to the appended value stays valid, but it is not found by lookups if overridden.
+    StringType& append(StringViewType section, StringViewType key, StringViewType value);
+    void commit();
+
+private:
+    struct PendingKey
+    {
+        const StringType *section;
+        const StringType *name;
+        StringType *value;
+    };
+
+    const StringType* intern(StringViewType name);
+    size_t lowerBoundSection(StringViewType name) const;
+    size_t lowerBoundKey(const Section &section, StringViewType name) const;
+
+private:
+    std::deque<StringType> namesPool;
+    std::unordered_map<StringViewType, const StringType*> namesIndex;
+    std::deque<StringType> valuesPool;
+    std::vector<Section> sectionsTable;
+    std::vector<Key> keysTable;
+    std::vector<PendingKey> pendingKeys;
+};
+
+
+}
+
+
+#endif
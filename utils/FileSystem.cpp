@@ -1,231 +1,924 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "FileSystem.h"
-#include "WindowsCommon.h"
-#include <Shlobj.h>
-
-
-#define SYSTEM_PATH_DELIM      L"\\"
-
-
-namespace Loader
-{
-
-namespace FileSystem
-{
-
-
-std::wstring getExecutablePath()
-{
-    std::wstring exePath(MAX_PATH, 0);
-
-    const DWORD len = GetModuleFileNameW(MY_HINSTANCE, &exePath.front(), MAX_PATH);
-
-    if (len > 0)
-    {
-        exePath.erase((size_t)len);
-    }
-    else
-    {
-        exePath.clear();
-    }
-
-    return exePath;
-}
-
-
-std::wstring getExecutableDirPath()
-{
-    return getDirWithoutFile(getExecutablePath());
-}
-
-
-std::wstring getExecutableName()
-{
-    std::wstring exeName;
-
-    auto exePath = getExecutablePath();
-    if (!exePath.empty())
-    {
-        auto delimIndex = exePath.find_last_of(SYSTEM_PATH_DELIM);
-        if (delimIndex != std::string::npos)
-        {
-            exeName = exePath.substr(delimIndex + 1);
-        }
-    }
-
-    return exeName;
-}
-
-
-std::wstring getDirWithFile(const std::wstring &dir, const std::wstring &file)
-{
-    return  dir + SYSTEM_PATH_DELIM + file;
-}
-
-
-std::wstring getDirWithoutFile(const std::wstring &fullPath)
-{
-    std::wstring dir;
-
-    if (!fullPath.empty())
-    {
-        auto delimIndex = fullPath.find_last_of(SYSTEM_PATH_DELIM);
-        if (delimIndex != std::string::npos)
-        {
-            dir = fullPath.substr(0, delimIndex);
-        }
-    }
-
-    return dir;
-}
-
-
-size_t getFileSize(const std::wstring &filePath)
-{
-    size_t fileSize = 0;
-
-    WIN32_FILE_ATTRIBUTE_DATA fad = {0};
-    if (GetFileAttributesExW(filePath.c_str(), GetFileExInfoStandard, &fad))
-    {
-        LARGE_INTEGER liSize;
-        liSize.HighPart = fad.nFileSizeHigh;
-        liSize.LowPart = fad.nFileSizeLow;
-        if (liSize.QuadPart > 0)
-        {
-            fileSize = (size_t)liSize.QuadPart;
-        }
-    }
-
-    return fileSize;
-}
-
-
-bool isFileExist(const std::wstring &filePath)
-{
-    bool bExist = false;
-
-    if (!filePath.empty())
-    {
-        const auto attr = GetFileAttributesW(filePath.data());
-        bExist = (attr != INVALID_FILE_ATTRIBUTES) && (attr & FILE_ATTRIBUTE_DIRECTORY) == 0;
-    }
-
-    return bExist;
-}
-
-
-static int CALLBACK setDefaultPathInBrowseForFolderDialog(HWND hwnd, UINT uMsg, LPARAM lParam, LPARAM lpData)
-{
-    if (uMsg == BFFM_INITIALIZED && NULL != lpData)
-    {
-        SendMessage(hwnd, BFFM_SETSELECTION, TRUE, lpData);
-    }
-    return 0;
-}
-
-
-std::wstring browseForFolder(const std::wstring &title, const std::wstring &initialFolderPath)
-{
-    std::wstring folderPath;
-
-    BROWSEINFO params = {0};
-    params.hwndOwner = GetActiveWindow();
-    params.lpszTitle = title.c_str();
-
-    if (!initialFolderPath.empty())
-    {
-        params.lpfn = setDefaultPathInBrowseForFolderDialog;
-        params.lParam = (LPARAM)initialFolderPath.data();
-    }
-
-    LPITEMIDLIST pidl = SHBrowseForFolder(&params);
-
-    if (pidl != NULL)
-    {
-        wchar_t buffer[1024] = {0};
-
-        if (SHGetPathFromIDList(pidl, buffer) == TRUE)
-        {
-            folderPath = buffer;
-        }
-
-        CoTaskMemFree(pidl);
-    }
-
-    return folderPath;
-}
-
-
-FileLocker::FileLocker(const std::wstring &path)
-    : lockedFile(INVALID_HANDLE_VALUE)
-    , fileSize(0)
-    , bLocked(false)
-{
-    if (!path.empty())
-    {
-        lockedFile = CreateFileW(path.c_str(), FILE_READ_DATA, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-
-        if (lockedFile != INVALID_HANDLE_VALUE)
-        {
-            fileSize = SetFilePointer(lockedFile, 0, NULL, FILE_END);
-
-            OVERLAPPED overlapped = {0};
-            overlapped.Offset = 0;
-            overlapped.OffsetHigh = 0;
-            bLocked = LockFileEx(lockedFile, LOCKFILE_FAIL_IMMEDIATELY, 0, fileSize, 0, &overlapped);
-        }
-    }
-}
-
-
-FileLocker::~FileLocker()
-{
-    if (bLocked)
-    {
-        OVERLAPPED overlapped = {0};
-        overlapped.Offset = 0;
-        overlapped.OffsetHigh = 0;
-        UnlockFileEx(lockedFile, 0, fileSize, 0, &overlapped);
-    }
-
-    if (lockedFile != INVALID_HANDLE_VALUE)
-    {
-        CloseHandle(lockedFile);
-    }
-}
-
-
-bool FileLocker::isLocked() const
-{
-    return bLocked;
-}
-
-
-void* FileLocker::getFileHandle() const
-{
-    return lockedFile;
-}
-
-
-}}
-
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FileSystem.h"
+
+#ifdef _WIN32
+#include "WindowsCommon.h"
+#include <Shlobj.h>
+
+#define SYSTEM_PATH_DELIM      L"\\"
+#else
+#include "TextEncoding.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SYSTEM_PATH_DELIM      L"/"
+#endif
+
+
+namespace Loader
+{
+
+namespace FileSystem
+{
+
+const std::wstring kTempFileSuffix = L".tmp";
+const uint32_t kHashReadSize = 1024 * 1024;
+const uint64_t kHashViewSize = 64 * 1024 * 1024; // Multiple of the allocation granularity.
+
+
+#ifdef _WIN32
+
+std::wstring getExecutablePath()
+{
+    std::wstring exePath(MAX_PATH, 0);
+
+    const DWORD len = GetModuleFileNameW(MY_HINSTANCE, &exePath.front(), MAX_PATH);
+
+    if (len > 0)
+    {
+        exePath.erase((size_t)len);
+    }
+    else
+    {
+        exePath.clear();
+    }
+
+    return exePath;
+}
+
+
+std::wstring getProgramDataDirPath()
+{
+    std::wstring dirPath;
+    PWSTR knownFolderPath = nullptr;
+
+    if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_ProgramData, 0, NULL, &knownFolderPath)))
+    {
+        dirPath = knownFolderPath;
+    }
+
+    CoTaskMemFree(knownFolderPath);
+
+    return dirPath;
+}
+
+
+size_t getFileSize(const std::wstring &filePath)
+{
+    size_t fileSize = 0;
+
+    WIN32_FILE_ATTRIBUTE_DATA fad = {0};
+    if (GetFileAttributesExW(filePath.c_str(), GetFileExInfoStandard, &fad))
+    {
+        LARGE_INTEGER liSize;
+        liSize.HighPart = fad.nFileSizeHigh;
+        liSize.LowPart = fad.nFileSizeLow;
+        if (liSize.QuadPart > 0)
+        {
+            fileSize = (size_t)liSize.QuadPart;
+        }
+    }
+
+    return fileSize;
+}
+
+
+bool isFileExist(const std::wstring &filePath)
+{
+    bool bExist = false;
+
+    if (!filePath.empty())
+    {
+        const auto attr = GetFileAttributesW(filePath.data());
+        bExist = (attr != INVALID_FILE_ATTRIBUTES) && (attr & FILE_ATTRIBUTE_DIRECTORY) == 0;
+    }
+
+    return bExist;
+}
+
+
+bool getFileInfo(const std::wstring &filePath, FileInfo *outInfo)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fad = {0};
+    const bool isReceived = GetFileAttributesExW(filePath.c_str(), GetFileExInfoStandard, &fad) != FALSE &&
+        (fad.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+
+    if (isReceived)
+    {
+        outInfo->size = ((uint64_t)fad.nFileSizeHigh << 32) | fad.nFileSizeLow;
+        outInfo->lastWriteTime = ((uint64_t)fad.ftLastWriteTime.dwHighDateTime << 32) | fad.ftLastWriteTime.dwLowDateTime;
+    }
+
+    return isReceived;
+}
+
+
+bool getFileIdentity(void *fileHandle, FileIdentity *outIdentity)
+{
+    BY_HANDLE_FILE_INFORMATION info = {0};
+    const bool isReceived = GetFileInformationByHandle(fileHandle, &info) != FALSE;
+
+    if (isReceived)
+    {
+        memset(outIdentity, 0, sizeof(*outIdentity));
+        outIdentity->size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+        outIdentity->lastWriteTime = ((uint64_t)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+
+        // 128-bit id is unique on ReFS too, 64-bit file index is the fallback for older systems.
+        FILE_ID_INFO idInfo = {0};
+        if (GetFileInformationByHandleEx(fileHandle, FileIdInfo, &idInfo, sizeof(idInfo)))
+        {
+            outIdentity->volumeId = idInfo.VolumeSerialNumber;
+            memcpy(outIdentity->fileId, idInfo.FileId.Identifier, sizeof(outIdentity->fileId));
+        }
+        else
+        {
+            const uint64_t fileIndex = ((uint64_t)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+            outIdentity->volumeId = info.dwVolumeSerialNumber;
+            memcpy(outIdentity->fileId, &fileIndex, sizeof(fileIndex));
+        }
+    }
+
+    return isReceived;
+}
+
+
+// Fallback for handles that can not be mapped: page aligned buffer, so reads go straight to it.
+static bool hashFileByReads(HANDLE fileHandle, Sha256 *hasher)
+{
+    char *buffer = static_cast<char*>(VirtualAlloc(NULL, kHashReadSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    uint64_t offset = 0;
+    bool isHashed = buffer != nullptr;
+    DWORD readSize = isHashed ? kHashReadSize : 0;
+
+    // Positioned reads: position of the handle is not used and not changed.
+    while (readSize > 0)
+    {
+        OVERLAPPED overlapped = {0};
+        overlapped.Offset = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        readSize = 0;
+
+        if (ReadFile(fileHandle, buffer, kHashReadSize, &readSize, &overlapped))
+        {
+            hasher->update(buffer, readSize);
+            offset += readSize;
+        }
+        else
+        {
+            isHashed = GetLastError() == ERROR_HANDLE_EOF;
+        }
+    }
+
+    if (buffer != nullptr)
+    {
+        VirtualFree(buffer, 0, MEM_RELEASE);
+    }
+
+    return isHashed;
+}
+
+
+bool hashFile(void *fileHandle, Sha256::Digest *outDigest)
+{
+    Sha256 hasher;
+    LARGE_INTEGER fileSize = {0};
+    bool isHashed = GetFileSizeEx(fileHandle, &fileSize) != FALSE;
+
+    if (isHashed && fileSize.QuadPart > 0)
+    {
+        const HANDLE mapping = CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (mapping != NULL)
+        {
+            // Mapped by views of limited size, so big files do not exhaust address space of 32-bit process.
+            const uint64_t size = (uint64_t)fileSize.QuadPart;
+
+            for (uint64_t offset = 0; offset < size && isHashed; offset += kHashViewSize)
+            {
+                const SIZE_T viewSize = (SIZE_T)(size - offset < kHashViewSize ? size - offset : kHashViewSize);
+                const void *view = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(offset >> 32), (DWORD)offset, viewSize);
+
+                isHashed = view != nullptr;
+
+                if (isHashed)
+                {
+                    hasher.update(view, viewSize);
+                    UnmapViewOfFile(view);
+                }
+            }
+
+            CloseHandle(mapping);
+        }
+        else
+        {
+            isHashed = hashFileByReads(fileHandle, &hasher);
+        }
+    }
+
+    if (isHashed)
+    {
+        *outDigest = hasher.finish();
+    }
+
+    return isHashed;
+}
+
+
+static void removeFile(const std::wstring &filePath)
+{
+    DeleteFileW(filePath.c_str());
+}
+
+
+static bool writeTempFile(const std::wstring &tempFilePath, const char *data, size_t size, WriteDurability durability)
+{
+    bool isWritten = false;
+
+    HANDLE file = CreateFileW(tempFilePath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        DWORD written = 0;
+        isWritten = size <= MAXDWORD &&
+            WriteFile(file, data, (DWORD)size, &written, NULL) != FALSE && written == (DWORD)size &&
+            (durability != WriteDurability::FullSync || FlushFileBuffers(file) != FALSE);
+
+        CloseHandle(file);
+
+        if (!isWritten)
+        {
+            DeleteFileW(tempFilePath.c_str());
+        }
+    }
+
+    return isWritten;
+}
+
+
+static bool replaceWithTempFile(const std::wstring &tempFilePath, const std::wstring &filePath, WriteDurability durability)
+{
+    const DWORD moveFlags = durability == WriteDurability::None
+        ? MOVEFILE_REPLACE_EXISTING
+        : MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH;
+
+    const bool isReplaced = MoveFileExW(tempFilePath.c_str(), filePath.c_str(), moveFlags) != FALSE;
+
+    if (!isReplaced)
+    {
+        DeleteFileW(tempFilePath.c_str());
+    }
+
+    return isReplaced;
+}
+
+
+static int CALLBACK setDefaultPathInBrowseForFolderDialog(HWND hwnd, UINT uMsg, LPARAM lParam, LPARAM lpData)
+{
+    if (uMsg == BFFM_INITIALIZED && NULL != lpData)
+    {
+        SendMessage(hwnd, BFFM_SETSELECTION, TRUE, lpData);
+    }
+    return 0;
+}
+
+
+std::wstring browseForFolder(const std::wstring &title, const std::wstring &initialFolderPath)
+{
+    std::wstring folderPath;
+
+    BROWSEINFO params = {0};
+    params.hwndOwner = GetActiveWindow();
+    params.lpszTitle = title.c_str();
+
+    if (!initialFolderPath.empty())
+    {
+        params.lpfn = setDefaultPathInBrowseForFolderDialog;
+        params.lParam = (LPARAM)initialFolderPath.data();
+    }
+
+    LPITEMIDLIST pidl = SHBrowseForFolder(&params);
+
+    if (pidl != NULL)
+    {
+        wchar_t buffer[1024] = {0};
+
+        if (SHGetPathFromIDList(pidl, buffer) == TRUE)
+        {
+            folderPath = buffer;
+        }
+
+        CoTaskMemFree(pidl);
+    }
+
+    return folderPath;
+}
+
+
+FileLocker::FileLocker(const std::wstring &path)
+    : lockedFile(INVALID_HANDLE_VALUE)
+    , fileSize(0)
+    , bLocked(false)
+{
+    if (!path.empty())
+    {
+        lockedFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        if (lockedFile != INVALID_HANDLE_VALUE)
+        {
+            fileSize = SetFilePointer(lockedFile, 0, NULL, FILE_END);
+            SetFilePointer(lockedFile, 0, NULL, FILE_BEGIN); // Handle is read by signature verification.
+
+            OVERLAPPED overlapped = {0};
+            overlapped.Offset = 0;
+            overlapped.OffsetHigh = 0;
+            bLocked = LockFileEx(lockedFile, LOCKFILE_FAIL_IMMEDIATELY, 0, fileSize, 0, &overlapped);
+        }
+    }
+}
+
+
+FileLocker::~FileLocker()
+{
+    if (bLocked)
+    {
+        OVERLAPPED overlapped = {0};
+        overlapped.Offset = 0;
+        overlapped.OffsetHigh = 0;
+        UnlockFileEx(lockedFile, 0, fileSize, 0, &overlapped);
+    }
+
+    if (lockedFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(lockedFile);
+    }
+}
+
+
+MappedFile::MappedFile(const std::wstring &path)
+    : file(INVALID_HANDLE_VALUE)
+    , mapping(NULL)
+    , data(nullptr)
+    , size(0)
+    , bOpened(false)
+{
+    if (!path.empty())
+    {
+        // Editors and the atomic save of other instances must be able to write or replace the file while it is read.
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        LARGE_INTEGER fileSize = {0};
+        if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &fileSize))
+        {
+            if (fileSize.QuadPart == 0)
+            {
+                bOpened = true;
+            }
+            else if ((uint64_t)fileSize.QuadPart <= SIZE_MAX)
+            {
+                mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping != NULL)
+                {
+                    data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                    size = data != nullptr ? (size_t)fileSize.QuadPart : 0;
+                    bOpened = data != nullptr;
+                }
+            }
+        }
+    }
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping != NULL)
+    {
+        CloseHandle(mapping);
+    }
+
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file);
+    }
+}
+
+#else
+
+// Paths are UTF-8 on POSIX systems. File handles are descriptors stored in the pointer.
+static std::string toNativePath(const std::wstring &path)
+{
+    std::string nativePath;
+    TextEncoding::wideToUtf8(path.data(), path.size(), &nativePath);
+
+    return nativePath;
+}
+
+
+static int toDescriptor(void *fileHandle)
+{
+    return (int)(intptr_t)fileHandle;
+}
+
+
+static void* toHandle(int descriptor)
+{
+    return (void*)(intptr_t)descriptor;
+}
+
+
+// FILETIME ticks: 100 ns intervals since 1601-01-01.
+static uint64_t toFileTime(const struct timespec &time)
+{
+    const uint64_t kEpochDifference = 11644473600ULL;
+
+    return ((uint64_t)time.tv_sec + kEpochDifference) * 10000000ULL + (uint64_t)time.tv_nsec / 100;
+}
+
+
+static bool writeAll(int descriptor, const char *data, size_t size)
+{
+    bool isWritten = true;
+
+    while (size > 0 && isWritten)
+    {
+        const ssize_t written = write(descriptor, data, size);
+
+        isWritten = written > 0 || (written < 0 && errno == EINTR);
+
+        if (written > 0)
+        {
+            data += written;
+            size -= (size_t)written;
+        }
+    }
+
+    return isWritten;
+}
+
+
+std::wstring getExecutablePath()
+{
+    std::wstring exePath;
+    char buffer[4096] = {0};
+
+    const ssize_t len = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+
+    if (len > 0)
+    {
+        TextEncoding::utf8ToWide(buffer, (size_t)len, &exePath);
+    }
+
+    return exePath;
+}
+
+
+std::wstring getProgramDataDirPath()
+{
+    return std::wstring();
+}
+
+
+size_t getFileSize(const std::wstring &filePath)
+{
+    FileInfo info = {};
+
+    return getFileInfo(filePath, &info) ? (size_t)info.size : 0;
+}
+
+
+bool isFileExist(const std::wstring &filePath)
+{
+    FileInfo info = {};
+
+    return !filePath.empty() && getFileInfo(filePath, &info);
+}
+
+
+bool getFileInfo(const std::wstring &filePath, FileInfo *outInfo)
+{
+    struct stat status = {};
+    const bool isReceived = stat(toNativePath(filePath).c_str(), &status) == 0 && S_ISREG(status.st_mode);
+
+    if (isReceived)
+    {
+        outInfo->size = (uint64_t)status.st_size;
+        outInfo->lastWriteTime = toFileTime(status.st_mtim);
+    }
+
+    return isReceived;
+}
+
+
+bool getFileIdentity(void *fileHandle, FileIdentity *outIdentity)
+{
+    struct stat status = {};
+    const bool isReceived = fstat(toDescriptor(fileHandle), &status) == 0;
+
+    if (isReceived)
+    {
+        const uint64_t fileIndex = (uint64_t)status.st_ino;
+
+        memset(outIdentity, 0, sizeof(*outIdentity));
+        outIdentity->volumeId = (uint64_t)status.st_dev;
+        memcpy(outIdentity->fileId, &fileIndex, sizeof(fileIndex));
+        outIdentity->size = (uint64_t)status.st_size;
+        outIdentity->lastWriteTime = toFileTime(status.st_mtim);
+    }
+
+    return isReceived;
+}
+
+
+// Fallback for descriptors that can not be mapped. Positioned reads: file offset is not used and not changed.
+static bool hashFileByReads(int descriptor, Sha256 *hasher)
+{
+    std::string buffer(kHashReadSize, 0);
+    uint64_t offset = 0;
+    bool isHashed = true;
+    ssize_t readSize = 1;
+
+    while (readSize > 0 && isHashed)
+    {
+        readSize = pread(descriptor, &buffer[0], buffer.size(), (off_t)offset);
+
+        if (readSize > 0)
+        {
+            hasher->update(buffer.data(), (size_t)readSize);
+            offset += (uint64_t)readSize;
+        }
+        else
+        {
+            isHashed = readSize == 0 || errno == EINTR;
+            readSize = readSize < 0 && errno == EINTR ? 1 : readSize;
+        }
+    }
+
+    return isHashed;
+}
+
+
+bool hashFile(void *fileHandle, Sha256::Digest *outDigest)
+{
+    Sha256 hasher;
+    const int descriptor = toDescriptor(fileHandle);
+    struct stat status = {};
+    bool isHashed = fstat(descriptor, &status) == 0;
+
+    if (isHashed && status.st_size > 0)
+    {
+        const uint64_t size = (uint64_t)status.st_size;
+        bool isMapped = true;
+
+        for (uint64_t offset = 0; offset < size && isHashed && isMapped; offset += kHashViewSize)
+        {
+            const size_t viewSize = (size_t)(size - offset < kHashViewSize ? size - offset : kHashViewSize);
+            void *view = mmap(nullptr, viewSize, PROT_READ, MAP_PRIVATE, descriptor, (off_t)offset);
+
+            isMapped = view != MAP_FAILED;
+
+            if (isMapped)
+            {
+                hasher.update(view, viewSize);
+                munmap(view, viewSize);
+            }
+            else
+            {
+                // Only a file that was not hashed partially can fall back to reads.
+                isHashed = offset == 0 && hashFileByReads(descriptor, &hasher);
+            }
+        }
+    }
+
+    if (isHashed)
+    {
+        *outDigest = hasher.finish();
+    }
+
+    return isHashed;
+}
+
+
+static void removeFile(const std::wstring &filePath)
+{
+    unlink(toNativePath(filePath).c_str());
+}
+
+
+static bool writeTempFile(const std::wstring &tempFilePath, const char *data, size_t size, WriteDurability durability)
+{
+    bool isWritten = false;
+    const int file = open(toNativePath(tempFilePath).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (file >= 0)
+    {
+        isWritten = writeAll(file, data, size) && (durability != WriteDurability::FullSync || fsync(file) == 0);
+        isWritten = close(file) == 0 && isWritten;
+
+        if (!isWritten)
+        {
+            removeFile(tempFilePath);
+        }
+    }
+
+    return isWritten;
+}
+
+
+static bool replaceWithTempFile(const std::wstring &tempFilePath, const std::wstring &filePath, WriteDurability durability)
+{
+    bool isReplaced = rename(toNativePath(tempFilePath).c_str(), toNativePath(filePath).c_str()) == 0;
+
+    if (!isReplaced)
+    {
+        removeFile(tempFilePath);
+    }
+    else if (durability != WriteDurability::None)
+    {
+        // Rename is durable once the directory entry is on disk.
+        const std::wstring dirPath = getDirWithoutFile(filePath);
+        const int dir = open(toNativePath(dirPath.empty() ? L"." : dirPath).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        if (dir >= 0)
+        {
+            isReplaced = fsync(dir) == 0;
+            close(dir);
+        }
+    }
+
+    return isReplaced;
+}
+
+
+std::wstring browseForFolder(const std::wstring&, const std::wstring&)
+{
+    return std::wstring();
+}
+
+
+FileLocker::FileLocker(const std::wstring &path)
+    : lockedFile(toHandle(-1))
+    , fileSize(0)
+    , bLocked(false)
+{
+    if (!path.empty())
+    {
+        const int file = open(toNativePath(path).c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (file >= 0)
+        {
+            struct stat status = {};
+            fileSize = fstat(file, &status) == 0 ? (unsigned long)status.st_size : 0;
+
+            // Advisory shared lock: cooperating writers that take an exclusive lock are kept out.
+            lockedFile = toHandle(file);
+            bLocked = flock(file, LOCK_SH | LOCK_NB) == 0;
+        }
+    }
+}
+
+
+FileLocker::~FileLocker()
+{
+    const int file = toDescriptor(lockedFile);
+
+    if (bLocked)
+    {
+        flock(file, LOCK_UN);
+    }
+
+    if (file >= 0)
+    {
+        close(file);
+    }
+}
+
+
+MappedFile::MappedFile(const std::wstring &path)
+    : file(nullptr)
+    , mapping(nullptr)
+    , data(nullptr)
+    , size(0)
+    , bOpened(false)
+{
+    if (!path.empty())
+    {
+        const int descriptor = open(toNativePath(path).c_str(), O_RDONLY | O_CLOEXEC);
+
+        struct stat status = {};
+        if (descriptor >= 0 && fstat(descriptor, &status) == 0)
+        {
+            if (status.st_size == 0)
+            {
+                bOpened = true;
+            }
+            else if ((uint64_t)status.st_size <= SIZE_MAX)
+            {
+                void *view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+                if (view != MAP_FAILED)
+                {
+                    mapping = view;
+                    data = static_cast<const char*>(view);
+                    size = (size_t)status.st_size;
+                    bOpened = true;
+                }
+            }
+        }
+
+        // Mapping stays valid after the descriptor is closed.
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+    }
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, size);
+    }
+}
+
+#endif
+
+
+std::wstring getExecutableDirPath()
+{
+    return getDirWithoutFile(getExecutablePath());
+}
+
+
+std::wstring getExecutableName()
+{
+    std::wstring exeName;
+
+    auto exePath = getExecutablePath();
+    if (!exePath.empty())
+    {
+        auto delimIndex = exePath.find_last_of(SYSTEM_PATH_DELIM);
+        if (delimIndex != std::string::npos)
+        {
+            exeName = exePath.substr(delimIndex + 1);
+        }
+    }
+
+    return exeName;
+}
+
+
+std::wstring getDirWithFile(const std::wstring &dir, const std::wstring &file)
+{
+    return  dir + SYSTEM_PATH_DELIM + file;
+}
+
+
+std::wstring getDirWithoutFile(const std::wstring &fullPath)
+{
+    std::wstring dir;
+
+    if (!fullPath.empty())
+    {
+        auto delimIndex = fullPath.find_last_of(SYSTEM_PATH_DELIM);
+        if (delimIndex != std::string::npos)
+        {
+            dir = fullPath.substr(0, delimIndex);
+        }
+    }
+
+    return dir;
+}
+
+
+bool writeFileAtomically(const std::wstring &filePath, const char *data, size_t size, WriteDurability durability)
+{
+    bool isWritten = false;
+
+    if (!filePath.empty())
+    {
+        const std::wstring tempFilePath = filePath + kTempFileSuffix;
+
+        isWritten = writeTempFile(tempFilePath, data, size, durability) && replaceWithTempFile(tempFilePath, filePath, durability);
+    }
+
+    return isWritten;
+}
+
+
+WriteResult writeFileIfUnchanged(const std::wstring &filePath, const char *data, size_t size, WriteDurability durability,
+    const FileInfo &expectedInfo, FileInfo *outInfo)
+{
+    WriteResult result = WriteResult::Failed;
+
+    if (!filePath.empty())
+    {
+        const std::wstring tempFilePath = filePath + kTempFileSuffix;
+
+        // Rename keeps size and modification time, so state of the temporary file is the state of the written one.
+        if (writeTempFile(tempFilePath, data, size, durability) && getFileInfo(tempFilePath, outInfo))
+        {
+            FileInfo currentInfo = {};
+            getFileInfo(filePath, &currentInfo);
+
+            if (currentInfo.size != expectedInfo.size || currentInfo.lastWriteTime != expectedInfo.lastWriteTime)
+            {
+                removeFile(tempFilePath);
+                result = WriteResult::Conflict;
+            }
+            else if (replaceWithTempFile(tempFilePath, filePath, durability))
+            {
+                result = WriteResult::Written;
+            }
+        }
+        else
+        {
+            removeFile(tempFilePath);
+        }
+    }
+
+    return result;
+}
+
+
+uint64_t getContentHash(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ (uint8_t)data[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+
+bool FileLocker::isLocked() const
+{
+    return bLocked;
+}
+
+
+void* FileLocker::getFileHandle() const
+{
+    return lockedFile;
+}
+
+
+bool MappedFile::isOpened() const
+{
+    return bOpened;
+}
+
+
+bool MappedFile::isMapped() const
+{
+    return data != nullptr;
+}
+
+
+const char* MappedFile::getData() const
+{
+    return data;
+}
+
+
+size_t MappedFile::getSize() const
+{
+    return size;
+}
+
+
+
+}}
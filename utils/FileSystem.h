@@ -1,60 +1,128 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#ifndef __UTILS_FILE_SYSTEM_H__
-#define __UTILS_FILE_SYSTEM_H__
-
-
-#include <string>
-
-
-namespace Loader
-{
-
-namespace FileSystem
-{
-    std::wstring getExecutablePath();
-    std::wstring getExecutableDirPath();
-    std::wstring getExecutableName();
-    std::wstring getDirWithFile(const std::wstring &dir, const std::wstring &file);
-    std::wstring getDirWithoutFile(const std::wstring &fullPath);
-    size_t getFileSize(const std::wstring &filePath);
-    bool isFileExist(const std::wstring &filePath);
-    std::wstring browseForFolder(const std::wstring &title, const std::wstring &initialFolderPath);
-
-    class FileLocker
-    {
-    public:
-        explicit FileLocker(const std::wstring &path);
-        ~FileLocker();
-        bool isLocked() const;
-        void *getFileHandle() const;
-
-    private:
-        void* lockedFile;
-        unsigned long fileSize;
-        bool bLocked;
-    };
-}
-
-}
-
-
-#endif
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_FILE_SYSTEM_H__
+#define __UTILS_FILE_SYSTEM_H__
+
+
+#include "Sha256.h"
+#include <cstdint>
+#include <string>
+
+
+namespace Loader
+{
+
+namespace FileSystem
+{
+    enum class WriteDurability
+    {
+        None,     // Data is handed to the OS, rename is not forced to disk.
+        Flush,    // Rename is written through to disk.
+        FullSync  // File data is flushed to disk before the write through rename.
+    };
+
+    struct FileInfo
+    {
+        uint64_t size;
+        uint64_t lastWriteTime; // FILETIME ticks.
+    };
+
+    // Same file with the same content state: stays equal while the file is not modified, replaced or moved
+    // to another volume.
+    struct FileIdentity
+    {
+        uint64_t volumeId;
+        uint8_t fileId[16];
+        uint64_t size;
+        uint64_t lastWriteTime; // FILETIME ticks.
+    };
+
+    enum class WriteResult
+    {
+        Written,
+        Conflict, // File was changed since the expected state, nothing is written.
+        Failed
+    };
+
+    std::wstring getExecutablePath();
+    std::wstring getExecutableDirPath();
+    std::wstring getExecutableName();
+    std::wstring getProgramDataDirPath(); // Shared by all users, usually 'C:\ProgramData'.
+    std::wstring getDirWithFile(const std::wstring &dir, const std::wstring &file);
+    std::wstring getDirWithoutFile(const std::wstring &fullPath);
+    size_t getFileSize(const std::wstring &filePath);
+    bool isFileExist(const std::wstring &filePath);
+    bool getFileInfo(const std::wstring &filePath, FileInfo *outInfo);
+    // Both work with an open handle, e.g. of 'FileLocker', so they describe exactly the locked file.
+    bool getFileIdentity(void *fileHandle, FileIdentity *outIdentity);
+    bool hashFile(void *fileHandle, Sha256::Digest *outDigest);
+    // FNV-1a: cheap detection of changed content, not a protection against tampering.
+    uint64_t getContentHash(const char *data, size_t size);
+    // Writes data to a temporary file with a single call and replaces the target file with it by rename.
+    bool writeFileAtomically(const std::wstring &filePath, const char *data, size_t size, WriteDurability durability);
+    // Same as 'writeFileAtomically', but replaces the file only if its state is still 'expectedInfo'
+    // (zero size and time for a missing file). No lock is held: the check is done right before the rename,
+    // so the race window is as short as possible. 'outInfo' receives state of the written file.
+    WriteResult writeFileIfUnchanged(const std::wstring &filePath, const char *data, size_t size, WriteDurability durability,
+        const FileInfo &expectedInfo, FileInfo *outInfo);
+    std::wstring browseForFolder(const std::wstring &title, const std::wstring &initialFolderPath);
+
+    class FileLocker
+    {
+    public:
+        explicit FileLocker(const std::wstring &path);
+        ~FileLocker();
+        bool isLocked() const;
+        void *getFileHandle() const;
+
+    private:
+        void* lockedFile;
+        unsigned long fileSize;
+        bool bLocked;
+    };
+
+    // Read only memory mapping of the whole file. Writers and renames of the file are not blocked.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::wstring &path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile &operator=(const MappedFile&) = delete;
+        ~MappedFile();
+        // Empty file is opened, but not mapped. Missing, locked or unreadable file is not opened.
+        bool isOpened() const;
+        bool isMapped() const;
+        const char *getData() const;
+        size_t getSize() const;
+
+    private:
+        void* file;
+        void* mapping;
+        const char* data;
+        size_t size;
+        bool bOpened;
+    };
+}
+
+}
+
+
+#endif
+
@@ -0,0 +1,268 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FileWatcher.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+
+namespace Loader
+{
+
+
+#if defined(_WIN32)
+
+
+const DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+const DWORD kNotifyBufferSize = 4096;
+
+
+FileWatcher::FileWatcher()
+    : dirHandle(INVALID_HANDLE_VALUE)
+    , stopEvent(NULL)
+{}
+
+
+bool FileWatcher::start(const std::wstring &dirPath, const std::wstring &watchedFileName, const ChangeCallback &onChange)
+{
+    stop();
+
+    dirHandle = CreateFileW(dirPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+
+    stopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+
+    if (dirHandle != INVALID_HANDLE_VALUE && stopEvent != NULL)
+    {
+        fileName = watchedFileName;
+        callback = onChange;
+        watcherThread = std::thread(&FileWatcher::watch, this);
+    }
+    else
+    {
+        stop();
+    }
+
+    return isStarted();
+}
+
+
+void FileWatcher::stop()
+{
+    if (watcherThread.joinable())
+    {
+        SetEvent(stopEvent);
+        watcherThread.join();
+    }
+
+    if (dirHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(dirHandle);
+        dirHandle = INVALID_HANDLE_VALUE;
+    }
+
+    if (stopEvent != NULL)
+    {
+        CloseHandle(stopEvent);
+        stopEvent = NULL;
+    }
+}
+
+
+void FileWatcher::watch()
+{
+    // Notifications are DWORD aligned records.
+    DWORD buffer[kNotifyBufferSize / sizeof(DWORD)];
+    OVERLAPPED overlapped = {0};
+    overlapped.hEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+
+    bool isWatching = overlapped.hEvent != NULL;
+
+    while (isWatching)
+    {
+        isWatching = ReadDirectoryChangesW(dirHandle, buffer, sizeof(buffer), FALSE, kNotifyFilter, NULL, &overlapped, NULL) != FALSE;
+
+        const HANDLE events[] = {stopEvent, overlapped.hEvent};
+        DWORD received = 0;
+
+        isWatching = isWatching &&
+            WaitForMultipleObjects(2, events, FALSE, INFINITE) == WAIT_OBJECT_0 + 1 &&
+            GetOverlappedResult(dirHandle, &overlapped, &received, FALSE) != FALSE;
+
+        bool isChanged = isWatching && received == 0; // Buffer overflow, changes are unknown.
+
+        for (const char *record = reinterpret_cast<const char*>(buffer); isWatching && received > 0 && !isChanged;)
+        {
+            const FILE_NOTIFY_INFORMATION *info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(record);
+
+            isChanged = CompareStringOrdinal(info->FileName, (int)(info->FileNameLength / sizeof(wchar_t)),
+                fileName.c_str(), (int)fileName.size(), TRUE) == CSTR_EQUAL;
+
+            if (info->NextEntryOffset == 0)
+            {
+                break;
+            }
+
+            record += info->NextEntryOffset;
+        }
+
+        if (isChanged)
+        {
+            callback();
+        }
+    }
+
+    CancelIoEx(dirHandle, &overlapped);
+
+    if (overlapped.hEvent != NULL)
+    {
+        DWORD received = 0;
+        GetOverlappedResult(dirHandle, &overlapped, &received, TRUE);
+        CloseHandle(overlapped.hEvent);
+    }
+}
+
+
+#else
+
+
+FileWatcher::FileWatcher()
+    : notifyFd(-1)
+    , stopFd(-1)
+{}
+
+
+bool FileWatcher::start(const std::wstring &dirPath, const std::wstring &watchedFileName, const ChangeCallback &onChange)
+{
+    stop();
+
+    notifyFd = inotify_init1(IN_CLOEXEC);
+    stopFd = eventfd(0, EFD_CLOEXEC);
+
+    if (notifyFd >= 0 && stopFd >= 0 &&
+        inotify_add_watch(notifyFd, std::filesystem::path(dirPath).string().c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) >= 0)
+    {
+        fileName = watchedFileName;
+        narrowFileName = std::filesystem::path(watchedFileName).string();
+        callback = onChange;
+        watcherThread = std::thread(&FileWatcher::watch, this);
+    }
+    else
+    {
+        stop();
+    }
+
+    return isStarted();
+}
+
+
+void FileWatcher::stop()
+{
+    if (watcherThread.joinable())
+    {
+        const uint64_t value = 1;
+        (void)write(stopFd, &value, sizeof(value));
+        watcherThread.join();
+    }
+
+    if (notifyFd >= 0)
+    {
+        close(notifyFd);
+        notifyFd = -1;
+    }
+
+    if (stopFd >= 0)
+    {
+        close(stopFd);
+        stopFd = -1;
+    }
+}
+
+
+void FileWatcher::watch()
+{
+    alignas(inotify_event) char buffer[4096];
+    bool isWatching = true;
+
+    while (isWatching)
+    {
+        pollfd fds[] = {{stopFd, POLLIN, 0}, {notifyFd, POLLIN, 0}};
+
+        int ready = -1;
+
+        // Signals interrupt the wait, only the stop request or a real error ends it.
+        do
+        {
+            ready = poll(fds, 2, -1);
+        }
+        while (ready < 0 && errno == EINTR);
+
+        isWatching = ready > 0 && (fds[0].revents & POLLIN) == 0;
+
+        const ssize_t received = isWatching
+            ? read(notifyFd, buffer, sizeof(buffer))
+            : 0;
+
+        bool isChanged = false;
+
+        for (ssize_t offset = 0; offset < received && !isChanged;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+            isChanged = (event->mask & IN_Q_OVERFLOW) != 0 || (event->len > 0 && narrowFileName == event->name);
+            offset += sizeof(inotify_event) + event->len;
+        }
+
+        if (isChanged)
+        {
+            callback();
+        }
+    }
+}
+
+
+#endif
+
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+
+bool FileWatcher::isStarted() const
+{
+    return watcherThread.joinable();
+}
+
+
+}
+
+
+
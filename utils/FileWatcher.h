@@ -0,0 +1,75 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_FILE_WATCHER_H__
+#define __UTILS_FILE_WATCHER_H__
+
+
+#include <functional>
+#include <string>
+#include <thread>
+
+
+namespace Loader
+{
+
+// Watches a single file for changes with OS change notifications, without polling.
+// Windows backend uses 'ReadDirectoryChangesW', other platforms use 'inotify'.
+// Callback is called on the watcher thread for every notification, so it should only
+// post the event to the owner thread and leave debouncing to it.
+class FileWatcher
+{
+public:
+    typedef std::function<void()> ChangeCallback;
+
+    FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher &operator=(const FileWatcher&) = delete;
+    ~FileWatcher();
+
+    bool start(const std::wstring &dirPath, const std::wstring &fileName, const ChangeCallback &onChange);
+    void stop();
+    bool isStarted() const;
+
+private:
+    void watch();
+
+private:
+    std::wstring fileName;
+    ChangeCallback callback;
+    std::thread watcherThread;
+
+#if defined(_WIN32)
+    void* dirHandle;
+    void* stopEvent;
+#else
+    std::string narrowFileName;
+    int notifyFd;
+    int stopFd;
+#endif
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include "LatencyHistogram.h"
+#include <cmath>
+
+
+namespace Loader
+{
+
+
+namespace
+{
+    uint32_t getBitWidth(uint32_t value)
+    {
+        uint32_t width = 0;
+
+        while (value != 0)
+        {
+            value >>= 1;
+            width++;
+        }
+
+        return width;
+    }
+}
+
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+
+void LatencyHistogram::record(uint32_t value)
+{
+    buckets[getBucketIndex(value)]++;
+    sum += value;
+
+    if (count == 0 || value < min)
+    {
+        min = value;
+    }
+
+    if (value > max)
+    {
+        max = value;
+    }
+
+    count++;
+}
+
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets)
+    {
+        bucket = 0;
+    }
+
+    count = 0;
+    sum = 0;
+    min = 0;
+    max = 0;
+}
+
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count;
+}
+
+
+uint64_t LatencyHistogram::getSum() const
+{
+    return sum;
+}
+
+
+uint32_t LatencyHistogram::getMin() const
+{
+    return min;
+}
+
+
+uint32_t LatencyHistogram::getMax() const
+{
+    return max;
+}
+
+
+uint32_t LatencyHistogram::getMean() const
+{
+    return count != 0 ? (uint32_t)(sum / count) : 0;
+}
+
+
+uint32_t LatencyHistogram::getPercentile(double percentile) const
+{
+    uint32_t value = 0;
+
+    if (count != 0)
+    {
+        const double clamped = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+        uint64_t rank = (uint64_t)std::ceil(clamped / 100.0 * (double)count);
+        rank = rank == 0 ? 1 : (rank > count ? count : rank);
+
+        uint64_t seen = 0;
+        size_t index = 0;
+
+        for (; index < kBucketsCount; ++index)
+        {
+            seen += buckets[index];
+
+            if (seen >= rank)
+            {
+                break;
+            }
+        }
+
+        value = getBucketHighest(index);
+        value = value < min ? min : (value > max ? max : value);
+    }
+
+    return value;
+}
+
+
+uint64_t LatencyHistogram::getBucketCount(size_t index) const
+{
+    return index < kBucketsCount ? buckets[index] : 0;
+}
+
+
+size_t LatencyHistogram::getBucketIndex(uint32_t value)
+{
+    size_t index = value;
+
+    if (value >= 2 * kSubBuckets)
+    {
+        const uint32_t shift = getBitWidth(value) - (uint32_t)kSubBucketsBits - 1;
+        index = (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+    }
+
+    return index;
+}
+
+
+uint32_t LatencyHistogram::getBucketLowest(size_t index)
+{
+    uint32_t value = (uint32_t)index;
+
+    if (index >= 2 * kSubBuckets)
+    {
+        const uint32_t shift = (uint32_t)(index / kSubBuckets) - 1;
+        value = (uint32_t)(index % kSubBuckets + kSubBuckets) << shift;
+    }
+
+    return value;
+}
+
+
+uint32_t LatencyHistogram::getBucketHighest(size_t index)
+{
+    return index + 1 < kBucketsCount ? getBucketLowest(index + 1) - 1 : UINT32_MAX;
+}
+
+}
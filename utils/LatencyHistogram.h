@@ -0,0 +1,77 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef __UTILS_LATENCY_HISTOGRAM_H__
+#define __UTILS_LATENCY_HISTOGRAM_H__
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Loader
+{
+
+// Fixed size histogram of durations in microseconds with log-linear buckets, like HDR histograms:
+// values below 32 are counted exactly, every next power of two range is split into 16 equal buckets,
+// so any recorded value is known with relative error below 1/16. Covers the whole 'uint32_t' range.
+// Recording never allocates memory. Not thread safe.
+class LatencyHistogram
+{
+public:
+    static const size_t kSubBucketsBits = 4;
+    static const size_t kSubBuckets = (size_t)1 << kSubBucketsBits;
+    static const size_t kBucketsCount = (32 - kSubBucketsBits + 1) * kSubBuckets;
+
+    LatencyHistogram();
+
+    void record(uint32_t value);
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getSum() const;
+    uint32_t getMin() const; // Zero if nothing was recorded.
+    uint32_t getMax() const;
+    uint32_t getMean() const;
+    // Highest value of the bucket containing the value at 'percentile' (0..100) of recorded ones,
+    // clamped to the recorded range.
+    uint32_t getPercentile(double percentile) const;
+
+    uint64_t getBucketCount(size_t index) const;
+    static size_t getBucketIndex(uint32_t value);
+    static uint32_t getBucketLowest(size_t index);
+    static uint32_t getBucketHighest(size_t index);
+
+private:
+    uint64_t buckets[kBucketsCount];
+    uint64_t count;
+    uint64_t sum;
+    uint32_t min;
+    uint32_t max;
+
+};
+
+}
+
+
+#endif
+
+
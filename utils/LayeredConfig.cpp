@@ -0,0 +1,190 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LayeredConfig.h"
+#include "TextUtils.h"
+
+
+namespace Loader
+{
+
+template<>
+const std::string LayeredConfig<std::string>::kEmptyString = "";
+
+template<>
+const std::wstring LayeredConfig<std::wstring>::kEmptyString = L"";
+
+
+template<typename StringType>
+LayeredConfig<StringType>::LayeredConfig()
+    : topLayer(nullptr)
+{}
+
+
+template<typename StringType>
+void LayeredConfig<StringType>::setLayers(ConfigFile<StringType> *newTopLayer, const std::vector<const ConfigFile<StringType>*> &lowerLayers)
+{
+    topLayer = newTopLayer;
+
+    layers.clear();
+    layers.push_back(newTopLayer);
+    layers.insert(layers.end(), lowerLayers.begin(), lowerLayers.end());
+
+    resolutions.clear();
+}
+
+
+template<typename StringType>
+ConfigFile<StringType>* LayeredConfig<StringType>::getTopLayer() const
+{
+    return topLayer;
+}
+
+
+template<typename StringType>
+size_t LayeredConfig<StringType>::getLayersCount() const
+{
+    return layers.size();
+}
+
+
+template<typename StringType>
+const StringType& LayeredConfig<StringType>::getValue(StringViewType section, StringViewType key) const
+{
+    const Resolution &resolution = resolve(section, key);
+
+    return resolution.value != nullptr
+        ? *resolution.value
+        : kEmptyString;
+}
+
+
+template<typename StringType>
+int32_t LayeredConfig<StringType>::getValue(StringViewType section, StringViewType key, int32_t defVal) const
+{
+    int32_t value = defVal;
+
+    return TextUtils::parseInt(StringViewType(getValue(section, key)), &value)
+        ? value
+        : defVal;
+}
+
+
+template<typename StringType>
+StringType LayeredConfig<StringType>::getValue(StringViewType section, StringViewType key, const StringType &defVal) const
+{
+    const auto &strVal = getValue(section, key);
+
+    return strVal.empty()
+        ? defVal
+        : strVal;
+}
+
+
+template<typename StringType>
+size_t LayeredConfig<StringType>::getValueLayer(StringViewType section, StringViewType key) const
+{
+    return resolve(section, key).layerIndex;
+}
+
+
+template<typename StringType>
+void LayeredConfig<StringType>::setValue(StringViewType section, StringViewType key, StringViewType value)
+{
+    // Cached entries are invalidated by the generation of the top layer.
+    topLayer->setValue(section, key, value);
+}
+
+
+template<typename StringType>
+void LayeredConfig<StringType>::setValue(StringViewType section, StringViewType key, int32_t value)
+{
+    topLayer->setValue(section, key, value);
+}
+
+
+template<typename StringType>
+void LayeredConfig<StringType>::clearValue(StringViewType section, StringViewType key)
+{
+    topLayer->clearValue(section, key);
+}
+
+
+template<typename StringType>
+const typename LayeredConfig<StringType>::Resolution& LayeredConfig<StringType>::resolve(StringViewType section, StringViewType key) const
+{
+    section = TextUtils::trim(section);
+    key = TextUtils::trim(key);
+
+    auto sectionIt = resolutions.find(section);
+    if (sectionIt == resolutions.end())
+    {
+        sectionIt = resolutions.emplace(StringType(section), std::map<StringType, Resolution, std::less<>>()).first;
+    }
+
+    auto keyIt = sectionIt->second.find(key);
+    if (keyIt == sectionIt->second.end())
+    {
+        keyIt = sectionIt->second.emplace(StringType(key), Resolution{nullptr, layers.size(), UINT64_MAX}).first;
+    }
+
+    Resolution &resolution = keyIt->second;
+
+    // Generations only grow, so equal sums mean none of the inspected layers has changed.
+    // Layers below the resolved one can not affect the result.
+    if (resolution.generationsSum != getGenerationsSum(resolution.layerIndex))
+    {
+        resolution.value = nullptr;
+        resolution.layerIndex = layers.size();
+
+        for (size_t i = 0; i < layers.size() && resolution.value == nullptr; ++i)
+        {
+            const StringType *value = layers[i]->findValue(section, key);
+            if (value != nullptr && !value->empty())
+            {
+                resolution.value = value;
+                resolution.layerIndex = i;
+            }
+        }
+
+        resolution.generationsSum = getGenerationsSum(resolution.layerIndex);
+    }
+
+    return resolution;
+}
+
+
+template<typename StringType>
+uint64_t LayeredConfig<StringType>::getGenerationsSum(size_t lastLayerIndex) const
+{
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i <= lastLayerIndex && i < layers.size(); ++i)
+    {
+        sum += layers[i]->getGeneration();
+    }
+
+    return sum;
+}
+
+
+template class LayeredConfig<std::string>;
+template class LayeredConfig<std::wstring>;
+
+}
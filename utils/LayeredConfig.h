@@ -0,0 +1,93 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_LAYERED_CONFIG_H__
+#define __UTILS_LAYERED_CONFIG_H__
+
+
+#include "ConfigFile.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace Loader
+{
+
+// Read view over a stack of config files, ordered from the top layer to the bottom one.
+// A value is taken from the topmost layer that has a non empty value for its key: empty values are
+// treated as missing, like 'getValue' with a default does. Writes always go to the top layer.
+// Lookups are resolved once and cached per key. Every cached entry remembers the sum of generations
+// of the layers that were inspected to resolve it, so a change of a layer only invalidates
+// entries resolved at or below it, and nothing is copied or merged up front.
+template<typename StringType>
+class LayeredConfig
+{
+public:
+    typedef std::basic_string_view<typename StringType::value_type> StringViewType;
+
+    LayeredConfig();
+    LayeredConfig(const LayeredConfig&) = delete;
+    LayeredConfig &operator=(const LayeredConfig&) = delete;
+
+    // Layers are not owned and must outlive this view.
+    void setLayers(ConfigFile<StringType> *topLayer, const std::vector<const ConfigFile<StringType>*> &lowerLayers);
+    ConfigFile<StringType>* getTopLayer() const;
+    size_t getLayersCount() const;
+
+    const StringType& getValue(StringViewType section, StringViewType key) const;
+    int32_t getValue(StringViewType section, StringViewType key, int32_t defVal) const;
+    StringType getValue(StringViewType section, StringViewType key, const StringType &defVal) const;
+    // Returns index of the layer that provides the value, or layers count if no layer has it.
+    size_t getValueLayer(StringViewType section, StringViewType key) const;
+
+    void setValue(StringViewType section, StringViewType key, StringViewType value);
+    void setValue(StringViewType section, StringViewType key, int32_t value);
+    void clearValue(StringViewType section, StringViewType key);
+
+private:
+    struct Resolution
+    {
+        const StringType *value;
+        size_t layerIndex;
+        uint64_t generationsSum; // Of layers from the top one to 'layerIndex' inclusive.
+    };
+
+    const Resolution& resolve(StringViewType section, StringViewType key) const;
+    uint64_t getGenerationsSum(size_t lastLayerIndex) const;
+
+private:
+    std::vector<const ConfigFile<StringType>*> layers;
+    ConfigFile<StringType> *topLayer;
+    mutable std::map<StringType, std::map<StringType, Resolution, std::less<>>, std::less<>> resolutions;
+
+    static const StringType kEmptyString;
+
+};
+
+
+}
+
+
+#endif
+
+
+
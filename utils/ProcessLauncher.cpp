@@ -0,0 +1,163 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ProcessLauncher.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include "TextEncoding.h"
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+extern char **environ;
+#endif
+
+
+namespace Loader
+{
+
+#ifdef _WIN32
+
+bool CreateProcessLauncher::launch(const std::wstring &path, const std::wstring &args, void **outProcess)
+{
+    bool isLaunched = false;
+
+    if (!path.empty())
+    {
+        // Buffer must be writable, 'CreateProcessW' can modify it.
+        std::wstring commandLine = L"\"" + path + L"\"";
+        if (!args.empty())
+        {
+            commandLine.append(L" ").append(args);
+        }
+
+        STARTUPINFOW startupInfo = {0};
+        startupInfo.cb = sizeof(startupInfo);
+        startupInfo.dwFlags = STARTF_USESHOWWINDOW;
+        startupInfo.wShowWindow = SW_HIDE;
+
+        PROCESS_INFORMATION processInfo = {0};
+
+        isLaunched = CreateProcessW(path.c_str(), &commandLine[0], nullptr, nullptr, FALSE, CREATE_NO_WINDOW,
+            nullptr, nullptr, &startupInfo, &processInfo) != FALSE;
+
+        if (isLaunched)
+        {
+            CloseHandle(processInfo.hThread);
+
+            if (outProcess != nullptr)
+            {
+                *outProcess = processInfo.hProcess;
+            }
+            else
+            {
+                CloseHandle(processInfo.hProcess);
+            }
+        }
+    }
+
+    return isLaunched;
+}
+
+
+std::unique_ptr<IProcessLauncher> createProcessLauncher()
+{
+    return std::make_unique<CreateProcessLauncher>();
+}
+
+#else
+
+bool PosixSpawnLauncher::launch(const std::wstring &path, const std::wstring &args, void **outProcess)
+{
+    bool isLaunched = false;
+
+    if (!path.empty())
+    {
+        std::vector<std::string> arguments(1);
+        TextEncoding::wideToUtf8(path.data(), path.size(), &arguments[0]);
+
+        std::string argsText;
+        TextEncoding::wideToUtf8(args.data(), args.size(), &argsText);
+
+        for (size_t start = 0; start < argsText.size();)
+        {
+            size_t end = argsText.find(' ', start);
+            end = end != std::string::npos ? end : argsText.size();
+
+            if (end > start)
+            {
+                arguments.push_back(argsText.substr(start, end - start));
+            }
+
+            start = end + 1;
+        }
+
+        std::vector<char*> argv;
+        for (auto &argument : arguments)
+        {
+            argv.push_back(&argument[0]);
+        }
+        argv.push_back(nullptr);
+
+        // Child starts with default signal handlers and an empty signal mask.
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init(&attributes);
+
+        sigset_t signals;
+        sigemptyset(&signals);
+        posix_spawnattr_setsigmask(&attributes, &signals);
+        sigfillset(&signals);
+        posix_spawnattr_setsigdefault(&attributes, &signals);
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+        pid_t pid = 0;
+        isLaunched = posix_spawn(&pid, argv[0], nullptr, &attributes, argv.data(), environ) == 0;
+
+        posix_spawnattr_destroy(&attributes);
+
+        if (isLaunched && outProcess != nullptr)
+        {
+            *outProcess = reinterpret_cast<void*>((intptr_t)pid);
+        }
+        else if (isLaunched)
+        {
+            std::thread([pid]()
+            {
+                int status = 0;
+                waitpid(pid, &status, 0);
+            }).detach();
+        }
+    }
+
+    return isLaunched;
+}
+
+
+std::unique_ptr<IProcessLauncher> createProcessLauncher()
+{
+    return std::make_unique<PosixSpawnLauncher>();
+}
+
+#endif
+
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_PROCESS_LAUNCHER_H__
+#define __UTILS_PROCESS_LAUNCHER_H__
+
+
+#include <memory>
+#include <string>
+
+
+namespace Loader
+{
+
+// Starts a process without waiting for it.
+class IProcessLauncher
+{
+public:
+    virtual ~IProcessLauncher() {}
+
+    // 'args' is the command line after the executable path, arguments are separated by spaces.
+    // Optional 'outProcess' receives a handle of the started process (the process id on non Windows platforms)
+    // to wait for it, the caller owns it then: closes the handle or reaps the child.
+    virtual bool launch(const std::wstring &path, const std::wstring &args, void **outProcess) = 0;
+
+};
+
+
+#ifdef _WIN32
+
+// 'CreateProcessW' with an explicit command line: no shell, no console, no inherited handles.
+class CreateProcessLauncher : public IProcessLauncher
+{
+public:
+    bool launch(const std::wstring &path, const std::wstring &args, void **outProcess) override;
+
+};
+
+#else
+
+// 'posix_spawn' with the arguments split by spaces, not awaited child is reaped by a detached thread.
+class PosixSpawnLauncher : public IProcessLauncher
+{
+public:
+    bool launch(const std::wstring &path, const std::wstring &args, void **outProcess) override;
+
+};
+
+#endif
+
+
+// Backend of the current platform.
+std::unique_ptr<IProcessLauncher> createProcessLauncher();
+
+}
+
+
+#endif
+
+
+
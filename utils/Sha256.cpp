@@ -0,0 +1,406 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Sha256.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SHA256_USE_SHA_NI
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SHA256_TARGET_SHA_NI
+#else
+#include <cpuid.h>
+#define SHA256_TARGET_SHA_NI __attribute__((target("sha,sse4.1")))
+#endif
+#endif
+
+
+namespace Loader
+{
+
+static std::atomic<bool> isAccelerationEnabled(true);
+
+static const uint32_t kInitialState[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t kRoundConstants[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+
+static inline uint32_t rotateRight(uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+
+static inline uint32_t loadBigEndian(const uint8_t *data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+
+static inline void storeBigEndian(uint32_t value, uint8_t *data)
+{
+    data[0] = (uint8_t)(value >> 24);
+    data[1] = (uint8_t)(value >> 16);
+    data[2] = (uint8_t)(value >> 8);
+    data[3] = (uint8_t)value;
+}
+
+
+#ifdef SHA256_USE_SHA_NI
+
+static bool isShaNiSupported()
+{
+    int leaf1[4] = {0};
+    int leaf7[4] = {0};
+
+#if defined(_MSC_VER)
+    __cpuid(leaf1, 0);
+    const int maxLeaf = leaf1[0];
+    __cpuidex(leaf1, 1, 0);
+
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(leaf7, 7, 0);
+    }
+#else
+    unsigned int regs[4] = {0};
+    const unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+    __cpuid_count(1, 0, regs[0], regs[1], regs[2], regs[3]);
+    memcpy(leaf1, regs, sizeof(leaf1));
+
+    if (maxLeaf >= 7)
+    {
+        __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+        memcpy(leaf7, regs, sizeof(leaf7));
+    }
+#endif
+
+    const bool hasSsse3 = (leaf1[2] & (1 << 9)) != 0;
+    const bool hasSse41 = (leaf1[2] & (1 << 19)) != 0;
+    const bool hasSha = (leaf7[1] & (1 << 29)) != 0;
+
+    return hasSsse3 && hasSse41 && hasSha;
+}
+
+
+// SHA extensions keep the state as ABEF and CDGH halves and do two rounds per instruction.
+// Message schedule is kept in four registers rotated every four rounds.
+SHA256_TARGET_SHA_NI
+static void transformShaNi(uint32_t *state, const uint8_t *blocks, size_t blocksCount)
+{
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);   // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(temp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, temp, 0xF0);      // CDGH
+
+    for (size_t block = 0; block < blocksCount; ++block, blocks += 64)
+    {
+        const __m128i savedState0 = state0;
+        const __m128i savedState1 = state1;
+        __m128i message[4];
+
+        for (int group = 0; group < 16; ++group)
+        {
+            const int current = group & 3;
+
+            if (group < 4)
+            {
+                message[current] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + group * 16)), byteSwapMask);
+            }
+
+            __m128i words = _mm_add_epi32(message[current],
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRoundConstants + group * 4)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, words);
+
+            if (group >= 3 && group <= 14)
+            {
+                const int next = (group + 1) & 3;
+                temp = _mm_alignr_epi8(message[current], message[(group - 1) & 3], 4);
+                message[next] = _mm_sha256msg2_epu32(_mm_add_epi32(message[next], temp), message[current]);
+            }
+
+            words = _mm_shuffle_epi32(words, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, words);
+
+            if (group >= 1 && group <= 12)
+            {
+                const int previous = (group - 1) & 3;
+                message[previous] = _mm_sha256msg1_epu32(message[previous], message[current]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, savedState0);
+        state1 = _mm_add_epi32(state1, savedState1);
+    }
+
+    temp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+    state0 = _mm_blend_epi16(temp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, temp, 8);    // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+#endif
+
+
+Sha256::Sha256()
+{
+    reset();
+}
+
+
+void Sha256::reset()
+{
+    memcpy(state, kInitialState, sizeof(state));
+    bufferSize = 0;
+    totalSize = 0;
+}
+
+
+void Sha256::update(const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+    totalSize += size;
+
+    if (bufferSize > 0)
+    {
+        const size_t copySize = size < sizeof(buffer) - bufferSize ? size : sizeof(buffer) - bufferSize;
+        memcpy(buffer + bufferSize, bytes, copySize);
+        bufferSize += copySize;
+        bytes += copySize;
+        size -= copySize;
+
+        if (bufferSize == sizeof(buffer))
+        {
+            transform(buffer, 1);
+            bufferSize = 0;
+        }
+    }
+
+    // Whole blocks are hashed right from the input.
+    if (size >= sizeof(buffer))
+    {
+        const size_t blocksCount = size / sizeof(buffer);
+        transform(bytes, blocksCount);
+        bytes += blocksCount * sizeof(buffer);
+        size -= blocksCount * sizeof(buffer);
+    }
+
+    if (size > 0)
+    {
+        memcpy(buffer, bytes, size);
+        bufferSize = size;
+    }
+}
+
+
+Sha256::Digest Sha256::finish()
+{
+    const uint64_t totalBits = totalSize * 8;
+
+    // Padding: single '1' bit, zeros up to 56 bytes modulo 64 and the message length in bits.
+    uint8_t padding[72] = {0x80};
+    const size_t paddingSize = (bufferSize < 56 ? 56 : 120) - bufferSize;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        padding[paddingSize + i] = (uint8_t)(totalBits >> (56 - i * 8));
+    }
+
+    update(padding, paddingSize + 8);
+
+    Digest digest;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        storeBigEndian(state[i], digest.data() + i * 4);
+    }
+
+    reset();
+
+    return digest;
+}
+
+
+Sha256::Digest Sha256::hash(const void *data, size_t size)
+{
+    Sha256 hasher;
+    hasher.update(data, size);
+
+    return hasher.finish();
+}
+
+
+bool Sha256::fromHex(std::wstring_view hex, Digest *outDigest)
+{
+    bool isParsed = hex.size() == outDigest->size() * 2;
+
+    for (size_t i = 0; i < hex.size() && isParsed; ++i)
+    {
+        const wchar_t ch = hex[i];
+        int value = -1;
+
+        if (ch >= L'0' && ch <= L'9')
+        {
+            value = ch - L'0';
+        }
+        else if (ch >= L'a' && ch <= L'f')
+        {
+            value = ch - L'a' + 10;
+        }
+        else if (ch >= L'A' && ch <= L'F')
+        {
+            value = ch - L'A' + 10;
+        }
+
+        isParsed = value >= 0;
+
+        if (isParsed)
+        {
+            uint8_t &byte = (*outDigest)[i / 2];
+            byte = (i % 2 == 0) ? (uint8_t)(value << 4) : (uint8_t)(byte | value);
+        }
+    }
+
+    return isParsed;
+}
+
+
+std::string Sha256::toHex(const Digest &digest)
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+
+    std::string hex;
+    hex.reserve(digest.size() * 2);
+
+    for (const uint8_t byte : digest)
+    {
+        hex.push_back(kHexDigits[byte >> 4]);
+        hex.push_back(kHexDigits[byte & 0x0F]);
+    }
+
+    return hex;
+}
+
+
+bool Sha256::isAccelerated()
+{
+#ifdef SHA256_USE_SHA_NI
+    static const bool isSupported = isShaNiSupported();
+    return isSupported && isAccelerationEnabled.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+
+void Sha256::setAccelerationEnabled(bool isEnabled)
+{
+    isAccelerationEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+
+void Sha256::transform(const uint8_t *blocks, size_t blocksCount)
+{
+#ifdef SHA256_USE_SHA_NI
+    if (isAccelerated())
+    {
+        transformShaNi(state, blocks, blocksCount);
+        return;
+    }
+#endif
+
+    for (size_t block = 0; block < blocksCount; ++block, blocks += 64)
+    {
+        uint32_t w[64];
+
+        for (int i = 0; i < 16; ++i)
+        {
+            w[i] = loadBigEndian(blocks + i * 4);
+        }
+
+        for (int i = 16; i < 64; ++i)
+        {
+            const uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        for (int i = 0; i < 64; ++i)
+        {
+            const uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            const uint32_t choice = (e & f) ^ (~e & g);
+            const uint32_t temp1 = h + s1 + choice + kRoundConstants[i] + w[i];
+            const uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t temp2 = s0 + majority;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_SHA256_H__
+#define __UTILS_SHA256_H__
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+namespace Loader
+{
+
+// Incremental SHA-256 (FIPS 180-4).
+// Uses x86 SHA extensions when the CPU has them, portable implementation otherwise.
+class Sha256
+{
+public:
+    typedef std::array<uint8_t, 32> Digest;
+
+    Sha256();
+
+    void update(const void *data, size_t size);
+    Digest finish(); // Hasher is reset and can be reused.
+
+    static Digest hash(const void *data, size_t size);
+    static std::string toHex(const Digest &digest);
+    static bool fromHex(std::wstring_view hex, Digest *outDigest); // Exactly 64 hex digits, any case.
+    static bool isAccelerated();
+    // Allows to compare both implementations in tests and benchmarks, enabled by default.
+    static void setAccelerationEnabled(bool isEnabled);
+
+private:
+    void reset();
+    void transform(const uint8_t *blocks, size_t blocksCount);
+
+private:
+    uint32_t state[8];
+    uint8_t buffer[64];
+    size_t bufferSize;
+    uint64_t totalSize;
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,211 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SignatureCache.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace Loader
+{
+
+const uint32_t kSignatureCacheMagic = 0x5641424D; // 'MABV'
+const uint32_t kSignatureCacheVersion = 1;
+const uint32_t kMaxSignatureCacheEntries = 16;
+
+
+struct SignatureCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entriesCount;
+    uint32_t entrySize;
+};
+
+
+static bool isSameFile(const FileSystem::FileIdentity &left, const FileSystem::FileIdentity &right)
+{
+    return left.volumeId == right.volumeId && memcmp(left.fileId, right.fileId, sizeof(left.fileId)) == 0;
+}
+
+
+SignatureCache::SignatureCache(const std::wstring &path)
+    : path(path)
+    , hits(0)
+    , misses(0)
+    , rejected(0)
+    , isLoaded(false)
+{}
+
+
+bool SignatureCache::isTrusted(const FileSystem::FileIdentity &identity, const Sha256::Digest &contentHash, const Verifier &verify)
+{
+    bool isFound = false;
+    bool isPinned = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ensureLoaded();
+
+        isPinned = pinnedHashes.empty() ||
+            std::find(pinnedHashes.begin(), pinnedHashes.end(), contentHash) != pinnedHashes.end();
+
+        for (auto it = entries.begin(); it != entries.end() && !isFound; ++it)
+        {
+            if (isSameFile(it->identity, identity))
+            {
+                isFound = it->identity.size == identity.size &&
+                    it->identity.lastWriteTime == identity.lastWriteTime &&
+                    it->contentHash == contentHash;
+
+                if (!isFound)
+                {
+                    entries.erase(it); // File was changed, entry is stale.
+                    break;
+                }
+            }
+        }
+
+        if (!isPinned)
+        {
+            rejected++;
+        }
+        else if (isFound)
+        {
+            hits++;
+        }
+        else
+        {
+            misses++;
+        }
+    }
+
+    bool isTrustedFile = isFound && isPinned;
+
+    if (!isFound && isPinned && verify())
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Another thread could verify the same file meanwhile.
+        bool isKnown = false;
+        for (const auto &entry : entries)
+        {
+            isKnown = isKnown || (isSameFile(entry.identity, identity) && entry.contentHash == contentHash);
+        }
+
+        if (!isKnown)
+        {
+            if (entries.size() >= kMaxSignatureCacheEntries)
+            {
+                entries.erase(entries.begin());
+            }
+
+            entries.push_back(Entry{identity, contentHash});
+            save();
+        }
+
+        isTrustedFile = true;
+    }
+
+    return isTrustedFile;
+}
+
+
+void SignatureCache::setPinnedHashes(const std::vector<Sha256::Digest> &hashes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pinnedHashes = hashes;
+}
+
+
+bool SignatureCache::hasPinnedHashes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pinnedHashes.empty();
+}
+
+
+uint64_t SignatureCache::getHits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+
+uint64_t SignatureCache::getMisses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+
+uint64_t SignatureCache::getRejected() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return rejected;
+}
+
+
+void SignatureCache::ensureLoaded()
+{
+    if (!isLoaded)
+    {
+        isLoaded = true;
+
+        const FileSystem::MappedFile cache(path);
+        SignatureCacheHeader header = {};
+
+        if (cache.isMapped() && cache.getSize() >= sizeof(header))
+        {
+            memcpy(&header, cache.getData(), sizeof(header));
+
+            // Broken or foreign file is ignored, it is overwritten on the next successful verification.
+            if (header.magic == kSignatureCacheMagic &&
+                header.version == kSignatureCacheVersion &&
+                header.entrySize == sizeof(Entry) &&
+                header.entriesCount <= kMaxSignatureCacheEntries &&
+                cache.getSize() == sizeof(header) + header.entriesCount * sizeof(Entry))
+            {
+                entries.resize(header.entriesCount);
+                memcpy(entries.data(), cache.getData() + sizeof(header), header.entriesCount * sizeof(Entry));
+            }
+        }
+    }
+}
+
+
+bool SignatureCache::save() const
+{
+    SignatureCacheHeader header = {};
+    header.magic = kSignatureCacheMagic;
+    header.version = kSignatureCacheVersion;
+    header.entriesCount = (uint32_t)entries.size();
+    header.entrySize = sizeof(Entry);
+
+    std::string data;
+    data.reserve(sizeof(header) + entries.size() * sizeof(Entry));
+    data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+
+    // Losing the cache only costs one more verification.
+    return !path.empty() && FileSystem::writeFileAtomically(path, data.data(), data.size(), FileSystem::WriteDurability::None);
+}
+
+
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_SIGNATURE_CACHE_H__
+#define __UTILS_SIGNATURE_CACHE_H__
+
+
+#include "FileSystem.h"
+#include "Sha256.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace Loader
+{
+
+// Persistent list of executables that passed signature verification. Verification is skipped while
+// the file stays the same: same volume and file id, size, modification time and content hash, any
+// difference drops the entry. Failed verifications are never remembered. Thread safe.
+// The cache file is trusted as much as the folder it is stored in.
+// Optional pinned hashes restrict trusted files to exact builds: other content is rejected without verification.
+class SignatureCache
+{
+public:
+    typedef std::function<bool()> Verifier;
+
+    explicit SignatureCache(const std::wstring &path);
+    SignatureCache(const SignatureCache&) = delete;
+    SignatureCache &operator=(const SignatureCache&) = delete;
+
+    // Returns true for a remembered file, otherwise calls 'verify' (without holding the lock)
+    // and remembers the file if it succeeds.
+    bool isTrusted(const FileSystem::FileIdentity &identity, const Sha256::Digest &contentHash, const Verifier &verify);
+
+    // Empty list allows any file with a valid signature.
+    void setPinnedHashes(const std::vector<Sha256::Digest> &hashes);
+    bool hasPinnedHashes() const;
+
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    uint64_t getRejected() const; // Files with a valid identity but not pinned content.
+
+private:
+    struct Entry
+    {
+        FileSystem::FileIdentity identity;
+        Sha256::Digest contentHash;
+    };
+
+    void ensureLoaded();
+    bool save() const;
+
+private:
+    std::wstring path;
+    mutable std::mutex mutex;
+    std::vector<Entry> entries; // Oldest first.
+    std::vector<Sha256::Digest> pinnedHashes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t rejected;
+    bool isLoaded;
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_SNAPSHOT_PUBLISHER_H__
+#define __UTILS_SNAPSHOT_PUBLISHER_H__
+
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+namespace Loader
+{
+
+// RCU style publication of immutable values.
+// Writers publish a new version by an atomic pointer swap, readers take a reference counted
+// snapshot without locks and never wait for writers. A replaced version is released by the writer
+// after a grace period: readers announce themselves in one of two counters selected by the epoch
+// parity, writer flips the epoch and waits until the counters drain. Every reader that could have
+// loaded the old pointer has taken its reference by then, so the version is destroyed when the last
+// snapshot of it goes away.
+template<typename T>
+class SnapshotPublisher
+{
+private:
+    struct Version
+    {
+        template<typename... Args>
+        explicit Version(Args&&... args) : value(std::forward<Args>(args)...), references(1) {}
+
+        const T value;
+        std::atomic<uint32_t> references;
+    };
+
+public:
+    // Read only handle of a published version, keeps it alive while exists.
+    class Snapshot
+    {
+    public:
+        Snapshot() : version(nullptr) {}
+        Snapshot(const Snapshot &other) : version(other.version) { addReference(version); }
+        Snapshot(Snapshot &&other) noexcept : version(other.version) { other.version = nullptr; }
+        ~Snapshot() { releaseReference(version); }
+
+        Snapshot &operator=(Snapshot other) noexcept
+        {
+            std::swap(version, other.version);
+            return *this;
+        }
+
+        bool empty() const { return version == nullptr; }
+        const T& operator*() const { return version->value; }
+        const T* operator->() const { return &version->value; }
+
+    private:
+        friend class SnapshotPublisher;
+        explicit Snapshot(Version *version) : version(version) {}
+
+        Version *version;
+    };
+
+    SnapshotPublisher() : current(nullptr), epoch(0), readers{}, publishedVersions(0) {}
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher &operator=(const SnapshotPublisher&) = delete;
+
+    ~SnapshotPublisher()
+    {
+        // No readers may run concurrently with destruction, snapshots taken before stay valid.
+        releaseReference(current.load());
+    }
+
+    // Lock free and safe to call from any thread. Returns an empty snapshot if nothing is published yet.
+    Snapshot acquire() const
+    {
+        const uint32_t readerEpoch = epoch.load();
+        readers[readerEpoch & 1].fetch_add(1);
+
+        Version *version = current.load();
+        addReference(version);
+
+        readers[readerEpoch & 1].fetch_sub(1);
+
+        return Snapshot(version);
+    }
+
+    // Writers are serialized with each other, but never wait for snapshots to be released.
+    template<typename... Args>
+    void publish(Args&&... args)
+    {
+        Version *newVersion = new Version(std::forward<Args>(args)...);
+
+        std::lock_guard<std::mutex> lock(writerMutex);
+
+        Version *oldVersion = current.exchange(newVersion);
+
+        // Readers that start after a flip use the other counter. A stalled reader may have read the epoch
+        // before the previous publication, so both counters are drained, one after each flip.
+        for (int phase = 0; phase < 2; ++phase)
+        {
+            const uint32_t oldEpoch = epoch.fetch_add(1);
+            while (readers[oldEpoch & 1].load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        releaseReference(oldVersion);
+        publishedVersions++;
+    }
+
+    uint64_t getPublishedVersions() const
+    {
+        return publishedVersions.load();
+    }
+
+private:
+    static void addReference(Version *version)
+    {
+        if (version != nullptr)
+        {
+            version->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void releaseReference(Version *version)
+    {
+        if (version != nullptr && version->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete version;
+        }
+    }
+
+private:
+    std::atomic<Version*> current;
+    std::atomic<uint32_t> epoch;
+    mutable std::atomic<uint32_t> readers[2];
+    std::atomic<uint64_t> publishedVersions;
+    std::mutex writerMutex;
+
+};
+
+}
+
+
+#endif
+
+
+
@@ -0,0 +1,530 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextEncoding.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_ENCODING_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace Loader
+{
+
+namespace TextEncoding
+{
+
+const uint8_t kUtf8Bom[] = {0xEF, 0xBB, 0xBF};
+const uint8_t kUtf16LEBom[] = {0xFF, 0xFE};
+const uint8_t kUtf16BEBom[] = {0xFE, 0xFF};
+const uint32_t kReplacementChar = 0xFFFD;
+const bool kIsWide16 = sizeof(wchar_t) == 2;
+
+
+Encoding detect(const char *data, size_t size, size_t *outBomSize)
+{
+    Encoding encoding = Encoding::Utf8;
+    *outBomSize = 0;
+
+    if (size >= sizeof(kUtf8Bom) && memcmp(data, kUtf8Bom, sizeof(kUtf8Bom)) == 0)
+    {
+        encoding = Encoding::Utf8Bom;
+        *outBomSize = sizeof(kUtf8Bom);
+    }
+    else if (size >= sizeof(kUtf16LEBom) && memcmp(data, kUtf16LEBom, sizeof(kUtf16LEBom)) == 0)
+    {
+        encoding = Encoding::Utf16LE;
+        *outBomSize = sizeof(kUtf16LEBom);
+    }
+    else if (size >= sizeof(kUtf16BEBom) && memcmp(data, kUtf16BEBom, sizeof(kUtf16BEBom)) == 0)
+    {
+        encoding = Encoding::Utf16BE;
+        *outBomSize = sizeof(kUtf16BEBom);
+    }
+
+    return encoding;
+}
+
+
+#ifdef TEXT_ENCODING_USE_SSE2
+
+static uint32_t lowestBitIndex(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(value);
+#endif
+}
+
+
+// Widens 16 ASCII bytes to wide chars.
+static void storeWidened(__m128i chunk, wchar_t *out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_unpacklo_epi8(chunk, zero);
+    const __m128i high = _mm_unpackhi_epi8(chunk, zero);
+
+    if constexpr (kIsWide16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), high);
+    }
+    else
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+    }
+}
+
+
+// Narrows 16 wide chars to bytes if all of them are ASCII.
+static bool storeNarrowed(const wchar_t *text, char *out)
+{
+    __m128i packed;
+    __m128i highBits; // Bits above the lowest seven of all chars.
+
+    if constexpr (kIsWide16)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 8));
+
+        highBits = _mm_srli_epi16(_mm_or_si128(low, high), 7);
+        packed = _mm_packus_epi16(low, high);
+    }
+    else
+    {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 4));
+        const __m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 8));
+        const __m128i fourth = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 12));
+
+        highBits = _mm_srli_epi32(_mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth)), 7);
+        packed = _mm_packus_epi16(_mm_packs_epi32(first, second), _mm_packs_epi32(third, fourth));
+    }
+
+    const bool isAscii = _mm_movemask_epi8(_mm_cmpeq_epi8(highBits, _mm_setzero_si128())) == 0xFFFF;
+
+    if (isAscii)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    }
+
+    return isAscii;
+}
+
+#endif
+
+
+// Decodes one UTF-8 sequence starting at 'inOutPos', invalid or truncated sequences give U+FFFD.
+static uint32_t decodeUtf8Sequence(const uint8_t *data, size_t size, size_t *inOutPos)
+{
+    const size_t pos = *inOutPos;
+    const uint8_t lead = data[pos];
+    size_t length = 0;
+    uint32_t codePoint = 0;
+    uint32_t minCodePoint = 0;
+
+    if (lead < 0x80)
+    {
+        length = 1;
+        codePoint = lead;
+    }
+    else if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        length = 2;
+        codePoint = lead & 0x1F;
+        minCodePoint = 0x80;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        length = 3;
+        codePoint = lead & 0x0F;
+        minCodePoint = 0x800;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        length = 4;
+        codePoint = lead & 0x07;
+        minCodePoint = 0x10000;
+    }
+
+    size_t decoded = 1;
+
+    for (; decoded < length && pos + decoded < size && (data[pos + decoded] & 0xC0) == 0x80; ++decoded)
+    {
+        codePoint = (codePoint << 6) | (data[pos + decoded] & 0x3F);
+    }
+
+    *inOutPos = pos + decoded;
+
+    const bool isValid = length > 0 && decoded == length && codePoint >= minCodePoint && codePoint <= 0x10FFFF &&
+        (codePoint < 0xD800 || codePoint > 0xDFFF);
+
+    return isValid
+        ? codePoint
+        : kReplacementChar;
+}
+
+
+static wchar_t* appendCodePoint(uint32_t codePoint, wchar_t *out)
+{
+    if (kIsWide16 && codePoint >= 0x10000)
+    {
+        codePoint -= 0x10000;
+        *out++ = (wchar_t)(0xD800 + (codePoint >> 10));
+        *out++ = (wchar_t)(0xDC00 + (codePoint & 0x3FF));
+    }
+    else
+    {
+        *out++ = (wchar_t)codePoint;
+    }
+
+    return out;
+}
+
+
+static char* appendUtf8(uint32_t codePoint, char *out)
+{
+    if (codePoint < 0x80)
+    {
+        *out++ = (char)codePoint;
+    }
+    else if (codePoint < 0x800)
+    {
+        *out++ = (char)(0xC0 | (codePoint >> 6));
+        *out++ = (char)(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        *out++ = (char)(0xE0 | (codePoint >> 12));
+        *out++ = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        *out++ = (char)(0xF0 | (codePoint >> 18));
+        *out++ = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        *out++ = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codePoint & 0x3F));
+    }
+
+    return out;
+}
+
+
+// Reads one code point of wide text, unpaired surrogates give U+FFFD.
+static uint32_t readCodePoint(const wchar_t *text, size_t size, size_t *inOutPos)
+{
+    uint32_t codePoint = (uint32_t)text[(*inOutPos)++];
+
+    if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+    {
+        const uint32_t next = kIsWide16 && *inOutPos < size ? (uint32_t)text[*inOutPos] : 0;
+
+        if (codePoint <= 0xDBFF && next >= 0xDC00 && next <= 0xDFFF)
+        {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (next - 0xDC00);
+            (*inOutPos)++;
+        }
+        else
+        {
+            codePoint = kReplacementChar;
+        }
+    }
+    else if (codePoint > 0x10FFFF)
+    {
+        codePoint = kReplacementChar;
+    }
+
+    return codePoint;
+}
+
+
+void utf8ToWide(const char *data, size_t size, std::wstring *outText)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+    const size_t startSize = outText->size();
+
+    // Every code unit of the result takes at least one byte of the input.
+    outText->resize(startSize + size);
+
+    wchar_t *const outStart = &(*outText)[0] + startSize;
+    wchar_t *out = outStart;
+    size_t pos = 0;
+
+    while (pos < size)
+    {
+#ifdef TEXT_ENCODING_USE_SSE2
+        for (; pos + 16 <= size; pos += 16, out += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos));
+            const uint32_t nonAscii = (uint32_t)_mm_movemask_epi8(chunk);
+
+            if (nonAscii != 0)
+            {
+                const uint32_t asciiCount = lowestBitIndex(nonAscii);
+
+                for (uint32_t i = 0; i < asciiCount; ++i)
+                {
+                    out[i] = (wchar_t)bytes[pos + i];
+                }
+
+                pos += asciiCount;
+                out += asciiCount;
+                break;
+            }
+
+            storeWidened(chunk, out);
+        }
+
+        if (pos < size)
+#endif
+        {
+            out = appendCodePoint(decodeUtf8Sequence(bytes, size, &pos), out);
+        }
+    }
+
+    outText->resize(startSize + (size_t)(out - outStart));
+}
+
+
+void wideToUtf8(const wchar_t *text, size_t size, std::string *outBytes)
+{
+    const size_t startSize = outBytes->size();
+
+    // UTF-16 code unit takes at most three bytes, surrogate pair takes four.
+    outBytes->resize(startSize + size * (kIsWide16 ? 3 : 4));
+
+    char *const outStart = &(*outBytes)[0] + startSize;
+    char *out = outStart;
+    size_t pos = 0;
+
+    while (pos < size)
+    {
+#ifdef TEXT_ENCODING_USE_SSE2
+        for (; pos + 16 <= size && storeNarrowed(text + pos, out); pos += 16)
+        {
+            out += 16;
+        }
+
+        if (pos < size)
+#endif
+        {
+            out = appendUtf8(readCodePoint(text, size, &pos), out);
+        }
+    }
+
+    outBytes->resize(startSize + (size_t)(out - outStart));
+}
+
+
+static void utf16ToWide(const char *data, size_t size, bool isBigEndian, std::wstring *outText)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+    const size_t unitsCount = size / 2; // Odd trailing byte is dropped.
+    const size_t startSize = outText->size();
+
+    outText->resize(startSize + unitsCount);
+
+    wchar_t *const outStart = &(*outText)[0] + startSize;
+    wchar_t *out = outStart;
+    size_t unit = 0;
+
+    if constexpr (kIsWide16)
+    {
+        // Files are read on little endian hosts only.
+        if (!isBigEndian)
+        {
+            memcpy(out, bytes, unitsCount * 2);
+            unit = unitsCount;
+            out += unitsCount;
+        }
+#ifdef TEXT_ENCODING_USE_SSE2
+        else
+        {
+            for (; unit + 8 <= unitsCount; unit += 8, out += 8)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + unit * 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_or_si128(_mm_slli_epi16(chunk, 8), _mm_srli_epi16(chunk, 8)));
+            }
+        }
+#endif
+    }
+
+    for (; unit < unitsCount; ++unit)
+    {
+        const uint32_t codeUnit = isBigEndian
+            ? ((uint32_t)bytes[unit * 2] << 8) | bytes[unit * 2 + 1]
+            : ((uint32_t)bytes[unit * 2 + 1] << 8) | bytes[unit * 2];
+
+        const uint32_t nextUnit = unit + 1 < unitsCount
+            ? (isBigEndian
+                ? ((uint32_t)bytes[unit * 2 + 2] << 8) | bytes[unit * 2 + 3]
+                : ((uint32_t)bytes[unit * 2 + 3] << 8) | bytes[unit * 2 + 2])
+            : 0;
+
+        if (!kIsWide16 && codeUnit >= 0xD800 && codeUnit <= 0xDBFF && nextUnit >= 0xDC00 && nextUnit <= 0xDFFF)
+        {
+            *out++ = (wchar_t)(0x10000 + ((codeUnit - 0xD800) << 10) + (nextUnit - 0xDC00));
+            ++unit;
+        }
+        else if (!kIsWide16 && codeUnit >= 0xD800 && codeUnit <= 0xDFFF)
+        {
+            *out++ = (wchar_t)kReplacementChar;
+        }
+        else
+        {
+            *out++ = (wchar_t)codeUnit;
+        }
+    }
+
+    outText->resize(startSize + (size_t)(out - outStart));
+}
+
+
+static void wideToUtf16(const std::wstring &text, bool isBigEndian, std::string *outBytes)
+{
+    outBytes->reserve(outBytes->size() + text.size() * 2);
+
+    const auto appendUnit = [isBigEndian, outBytes](uint32_t codeUnit)
+    {
+        const char low = (char)(codeUnit & 0xFF);
+        const char high = (char)((codeUnit >> 8) & 0xFF);
+
+        outBytes->push_back(isBigEndian ? high : low);
+        outBytes->push_back(isBigEndian ? low : high);
+    };
+
+    if (kIsWide16 && !isBigEndian)
+    {
+        outBytes->append(reinterpret_cast<const char*>(text.data()), text.size() * 2);
+    }
+    else
+    {
+        for (size_t pos = 0; pos < text.size();)
+        {
+            uint32_t codePoint = kIsWide16
+                ? (uint32_t)text[pos++]
+                : readCodePoint(text.data(), text.size(), &pos);
+
+            if (codePoint >= 0x10000)
+            {
+                codePoint -= 0x10000;
+                appendUnit(0xD800 + (codePoint >> 10));
+                appendUnit(0xDC00 + (codePoint & 0x3FF));
+            }
+            else
+            {
+                appendUnit(codePoint);
+            }
+        }
+    }
+}
+
+
+template<typename StringType>
+void decode(const char *data, size_t size, Encoding encoding, StringType *outText)
+{
+    if (encoding == Encoding::Utf16LE || encoding == Encoding::Utf16BE)
+    {
+        if constexpr (std::is_same_v<typename StringType::value_type, char>)
+        {
+            std::wstring wideText;
+            utf16ToWide(data, size, encoding == Encoding::Utf16BE, &wideText);
+            wideToUtf8(wideText.data(), wideText.size(), outText);
+        }
+        else
+        {
+            utf16ToWide(data, size, encoding == Encoding::Utf16BE, outText);
+        }
+    }
+    else
+    {
+        if constexpr (std::is_same_v<typename StringType::value_type, char>)
+        {
+            outText->append(data, size);
+        }
+        else
+        {
+            utf8ToWide(data, size, outText);
+        }
+    }
+}
+
+
+template<typename StringType>
+void encode(const StringType &text, Encoding encoding, std::string *outBytes)
+{
+    if (encoding == Encoding::Utf16LE || encoding == Encoding::Utf16BE)
+    {
+        const bool isBigEndian = encoding == Encoding::Utf16BE;
+
+        outBytes->append(reinterpret_cast<const char*>(isBigEndian ? kUtf16BEBom : kUtf16LEBom), sizeof(kUtf16LEBom));
+
+        if constexpr (std::is_same_v<typename StringType::value_type, char>)
+        {
+            std::wstring wideText;
+            utf8ToWide(text.data(), text.size(), &wideText);
+            wideToUtf16(wideText, isBigEndian, outBytes);
+        }
+        else
+        {
+            wideToUtf16(text, isBigEndian, outBytes);
+        }
+    }
+    else
+    {
+        if (encoding == Encoding::Utf8Bom)
+        {
+            outBytes->append(reinterpret_cast<const char*>(kUtf8Bom), sizeof(kUtf8Bom));
+        }
+
+        if constexpr (std::is_same_v<typename StringType::value_type, char>)
+        {
+            outBytes->append(text);
+        }
+        else
+        {
+            wideToUtf8(text.data(), text.size(), outBytes);
+        }
+    }
+}
+
+
+template void decode<std::string>(const char*, size_t, Encoding, std::string*);
+template void decode<std::wstring>(const char*, size_t, Encoding, std::wstring*);
+template void encode<std::string>(const std::string&, Encoding, std::string*);
+template void encode<std::wstring>(const std::wstring&, Encoding, std::string*);
+
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_TEXT_ENCODING_H__
+#define __UTILS_TEXT_ENCODING_H__
+
+
+#include <cstddef>
+#include <string>
+
+
+namespace Loader
+{
+
+namespace TextEncoding
+{
+    enum class Encoding
+    {
+        Utf8,    // No BOM, also used for plain ASCII files.
+        Utf8Bom,
+        Utf16LE, // Detected by BOM only.
+        Utf16BE  // Detected by BOM only.
+    };
+
+    // Detects encoding of the file content by its BOM, 'outBomSize' receives size of the BOM in bytes.
+    Encoding detect(const char *data, size_t size, size_t *outBomSize);
+
+    // Whole buffer transcoders with an ASCII fast path. Results are appended to the output,
+    // invalid sequences are replaced by U+FFFD. Wide strings are UTF-16 where wchar_t is 16 bit
+    // and UTF-32 otherwise.
+    void utf8ToWide(const char *data, size_t size, std::wstring *outText);
+    void wideToUtf8(const wchar_t *text, size_t size, std::string *outBytes);
+
+    // Decodes file content without BOM, 'StringType' selects UTF-8 or wide text.
+    template<typename StringType>
+    void decode(const char *data, size_t size, Encoding encoding, StringType *outText);
+
+    // Encodes text as file content, BOM is written for encodings that have it.
+    template<typename StringType>
+    void encode(const StringType &text, Encoding encoding, std::string *outBytes);
+}
+
+}
+
+
+#endif
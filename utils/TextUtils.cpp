@@ -0,0 +1,260 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextUtils.h"
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_UTILS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace Loader
+{
+
+namespace TextUtils
+{
+
+static const bool kAsciiSpaces[128] =
+{
+    false, false, false, false, false, false, false, false, false, true,  true,  true,  true,  true,  false, false, // 0x00 - 0x0F
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, // 0x10 - 0x1F
+    true,  false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, // 0x20 - 0x2F
+};
+
+
+static bool isUnicodeSpace(uint32_t codeUnit)
+{
+    return
+        codeUnit == 0x0085 || codeUnit == 0x00A0 || codeUnit == 0x1680 ||
+        (codeUnit >= 0x2000 && codeUnit <= 0x200A) ||
+        codeUnit == 0x2028 || codeUnit == 0x2029 || codeUnit == 0x202F || codeUnit == 0x205F ||
+        codeUnit == 0x3000;
+}
+
+
+template<typename CharType>
+bool isSpace(CharType ch)
+{
+    typedef std::make_unsigned_t<CharType> UnsignedCharType;
+    const uint32_t codeUnit = (uint32_t)(UnsignedCharType)ch;
+
+    return codeUnit < 0x80
+        ? kAsciiSpaces[codeUnit]
+        : sizeof(CharType) > 1 && isUnicodeSpace(codeUnit);
+}
+
+
+#ifdef TEXT_UTILS_USE_SSE2
+
+static uint32_t lowestBitIndex(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(value);
+#endif
+}
+
+
+static uint32_t highestBitIndex(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)(31 - __builtin_clz(value));
+#endif
+}
+
+
+// Returns 16 bit mask where each set bit marks a byte of the block that is an ASCII space.
+template<typename CharType>
+static uint32_t getAsciiSpacesMask(const CharType *block)
+{
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+    const __m128i zero = _mm_setzero_si128();
+
+    // Space is ' ' or a code unit in range ['\t', '\r'].
+    if constexpr (sizeof(CharType) == 1)
+    {
+        const __m128i isControlSpace = _mm_cmpeq_epi8(
+            _mm_subs_epu8(_mm_sub_epi8(chunk, _mm_set1_epi8('\t')), _mm_set1_epi8('\r' - '\t')), zero);
+        const __m128i isBlank = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+
+        return (uint32_t)_mm_movemask_epi8(_mm_or_si128(isControlSpace, isBlank));
+    }
+    else
+    {
+        const __m128i isControlSpace = _mm_cmpeq_epi16(
+            _mm_subs_epu16(_mm_sub_epi16(chunk, _mm_set1_epi16('\t')), _mm_set1_epi16('\r' - '\t')), zero);
+        const __m128i isBlank = _mm_cmpeq_epi16(chunk, _mm_set1_epi16(' '));
+
+        return (uint32_t)_mm_movemask_epi8(_mm_or_si128(isControlSpace, isBlank));
+    }
+}
+
+#endif
+
+
+// Skips leading ASCII spaces by blocks. Result is a position of the first code unit
+// that needs the scalar check.
+template<typename CharType>
+static size_t skipAsciiSpacesForward(const CharType *data, size_t size)
+{
+    size_t pos = 0;
+
+#ifdef TEXT_UTILS_USE_SSE2
+    if constexpr (sizeof(CharType) <= 2)
+    {
+        const size_t unitsPerBlock = 16 / sizeof(CharType);
+
+        for (; pos + unitsPerBlock <= size; pos += unitsPerBlock)
+        {
+            const uint32_t nonSpaces = ~getAsciiSpacesMask(data + pos) & 0xFFFF;
+            if (nonSpaces != 0)
+            {
+                return pos + lowestBitIndex(nonSpaces) / sizeof(CharType);
+            }
+        }
+    }
+#endif
+
+    return pos;
+}
+
+
+// Skips trailing ASCII spaces by blocks. Result is a size of the remaining prefix.
+template<typename CharType>
+static size_t skipAsciiSpacesBackward(const CharType *data, size_t size)
+{
+#ifdef TEXT_UTILS_USE_SSE2
+    if constexpr (sizeof(CharType) <= 2)
+    {
+        const size_t unitsPerBlock = 16 / sizeof(CharType);
+
+        for (; size >= unitsPerBlock; size -= unitsPerBlock)
+        {
+            const uint32_t nonSpaces = ~getAsciiSpacesMask(data + size - unitsPerBlock) & 0xFFFF;
+            if (nonSpaces != 0)
+            {
+                return size - unitsPerBlock + highestBitIndex(nonSpaces) / sizeof(CharType) + 1;
+            }
+        }
+    }
+#endif
+
+    return size;
+}
+
+
+template<typename CharType>
+std::basic_string_view<CharType> trimLeft(std::basic_string_view<CharType> str)
+{
+    size_t pos = skipAsciiSpacesForward(str.data(), str.size());
+
+    while (pos < str.size() && isSpace(str[pos]))
+    {
+        ++pos;
+    }
+
+    return str.substr(pos);
+}
+
+
+template<typename CharType>
+std::basic_string_view<CharType> trimRight(std::basic_string_view<CharType> str)
+{
+    size_t size = skipAsciiSpacesBackward(str.data(), str.size());
+
+    while (size > 0 && isSpace(str[size - 1]))
+    {
+        --size;
+    }
+
+    return str.substr(0, size);
+}
+
+
+template<typename CharType>
+std::basic_string_view<CharType> trim(std::basic_string_view<CharType> str)
+{
+    return trimRight(trimLeft(str));
+}
+
+
+template<typename CharType>
+bool parseInt(std::basic_string_view<CharType> str, int32_t *outValue)
+{
+    str = trimLeft(str);
+
+    const bool isNegative = !str.empty() && str.front() == '-';
+    if (!str.empty() && (str.front() == '-' || str.front() == '+'))
+    {
+        str.remove_prefix(1);
+    }
+
+    int64_t value = 0;
+    size_t digitsCount = 0;
+
+    for (; digitsCount < str.size() && str[digitsCount] >= '0' && str[digitsCount] <= '9'; ++digitsCount)
+    {
+        value = value * 10 + (str[digitsCount] - '0');
+        if (value > (int64_t)INT32_MAX + 1)
+        {
+            return false;
+        }
+    }
+
+    value = isNegative ? -value : value;
+
+    if (digitsCount == 0 || value > INT32_MAX)
+    {
+        return false;
+    }
+
+    *outValue = (int32_t)value;
+
+    return true;
+}
+
+
+template bool isSpace<char>(char);
+template bool isSpace<wchar_t>(wchar_t);
+template std::basic_string_view<char> trimLeft<char>(std::basic_string_view<char>);
+template std::basic_string_view<wchar_t> trimLeft<wchar_t>(std::basic_string_view<wchar_t>);
+template std::basic_string_view<char> trimRight<char>(std::basic_string_view<char>);
+template std::basic_string_view<wchar_t> trimRight<wchar_t>(std::basic_string_view<wchar_t>);
+template std::basic_string_view<char> trim<char>(std::basic_string_view<char>);
+template std::basic_string_view<wchar_t> trim<wchar_t>(std::basic_string_view<wchar_t>);
+template bool parseInt<char>(std::basic_string_view<char>, int32_t*);
+template bool parseInt<wchar_t>(std::basic_string_view<wchar_t>, int32_t*);
+
+}
+
+}
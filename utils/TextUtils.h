@@ -0,0 +1,58 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_TEXT_UTILS_H__
+#define __UTILS_TEXT_UTILS_H__
+
+
+#include <cstdint>
+#include <string_view>
+
+
+namespace Loader
+{
+
+namespace TextUtils
+{
+    // Locale independent whitespace test.
+    // ASCII code units are classified with a lookup table, wide non-ASCII code units
+    // are checked against the Unicode 'White_Space' property. Single byte non-ASCII
+    // code units (parts of UTF-8 sequences) are never treated as spaces.
+    template<typename CharType>
+    bool isSpace(CharType ch);
+
+    template<typename CharType>
+    std::basic_string_view<CharType> trimLeft(std::basic_string_view<CharType> str);
+
+    template<typename CharType>
+    std::basic_string_view<CharType> trimRight(std::basic_string_view<CharType> str);
+
+    template<typename CharType>
+    std::basic_string_view<CharType> trim(std::basic_string_view<CharType> str);
+
+    // Parses decimal integer like 'std::stoi' does (leading spaces, optional sign, digits up to
+    // the first non digit), but without exceptions and memory allocations.
+    template<typename CharType>
+    bool parseInt(std::basic_string_view<CharType> str, int32_t *outValue);
+}
+
+}
+
+
+#endif
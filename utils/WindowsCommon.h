@@ -1,58 +1,76 @@
-/*
- * This file is part of the 'MSI Afterburner Profile Loader'
- * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
- * Copyright (c) Alexander P
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, version 3.
- *
- * This program is distributed in the hope that it will be useful, but
- * WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
- * General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#ifndef __UTILS_WINDOWS_COMMON_H__
-#define __UTILS_WINDOWS_COMMON_H__
-
-
-#include <Windows.h>
-#include <string>
-
-
-EXTERN_C IMAGE_DOS_HEADER __ImageBase;
-#define MY_HINSTANCE ((HINSTANCE)&__ImageBase)
-
-
-namespace Loader
-{
-
-namespace WindowsCommon
-{
-    void registerWindowClass(PCWSTR pszClassName, WNDPROC lpfnWndProc);
-    bool safeValidateExeSignature(const std::wstring &path);
-    bool exec(const std::wstring &path, const std::wstring &args);
-    bool safeExec(const std::wstring &path, const std::wstring &args);
-    bool open(const wchar_t *link, bool asUser);
-    std::wstring getAppVersion(const std::wstring &appPath);
-}
-
-
-static class ComInitializer
-{
-public:
-    ComInitializer();
-    ~ComInitializer();
-} _globalComInitializer;
-
-}
-
-
-#endif
-
-
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_WINDOWS_COMMON_H__
+#define __UTILS_WINDOWS_COMMON_H__
+
+
+#include <Windows.h>
+#include <cstdint>
+#include <string>
+
+
+EXTERN_C IMAGE_DOS_HEADER __ImageBase;
+#define MY_HINSTANCE ((HINSTANCE)&__ImageBase)
+
+
+namespace Loader
+{
+
+class IProcessLauncher;
+class SignatureCache;
+
+namespace WindowsCommon
+{
+    // Durations of the 'safeExec' stages.
+    struct ExecTimings
+    {
+        uint32_t openMicroseconds;   // Opening and locking the executable.
+        uint32_t hashMicroseconds;   // File identity and content hash.
+        uint32_t verifyMicroseconds; // Signature cache lookup and signature verification on a miss.
+        uint32_t launchMicroseconds;
+    };
+
+    void registerWindowClass(PCWSTR pszClassName, WNDPROC lpfnWndProc);
+    // Optional 'signatureCache' skips verification of an executable that was already verified and not changed since.
+    bool safeValidateExeSignature(const std::wstring &path, SignatureCache *signatureCache = nullptr);
+    // Opens the executable once and keeps it locked against writes while it is verified and started.
+    // Process is started by 'launcher', by 'CreateProcessW' if it is null. Optional 'outProcess' receives
+    // handle of the started process, the caller closes it.
+    bool safeExec(const std::wstring &path, const std::wstring &args, SignatureCache *signatureCache = nullptr,
+        ExecTimings *outTimings = nullptr, IProcessLauncher *launcher = nullptr, HANDLE *outProcess = nullptr);
+    bool open(const wchar_t *link, bool asUser);
+    std::wstring getAppVersion(const std::wstring &appPath);
+    bool isProcessRunning(const std::wstring &exeName); // Any process of any user with this executable name.
+}
+
+
+static class ComInitializer
+{
+public:
+    ComInitializer();
+    ~ComInitializer();
+} _globalComInitializer;
+
+}
+
+
+#endif
+
+
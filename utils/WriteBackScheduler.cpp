@@ -0,0 +1,101 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "WriteBackScheduler.h"
+
+
+namespace Loader
+{
+
+
+WriteBackScheduler::WriteBackScheduler(uint32_t quietPeriodMs, const WriteFunction &writeFunction)
+    : writeFunction(writeFunction)
+    , quietPeriodMs(quietPeriodMs)
+    , isDirtyFlag(false)
+    , requestedWrites(0)
+    , performedWrites(0)
+    , coalescedWrites(0)
+{}
+
+
+void WriteBackScheduler::setQuietPeriod(uint32_t newQuietPeriodMs)
+{
+    quietPeriodMs = newQuietPeriodMs;
+}
+
+
+uint32_t WriteBackScheduler::getQuietPeriod() const
+{
+    return quietPeriodMs;
+}
+
+
+void WriteBackScheduler::markDirty()
+{
+    // Failed or not yet flushed write stays pending, so the request is served by it.
+    if (isDirtyFlag)
+    {
+        coalescedWrites++;
+    }
+
+    isDirtyFlag = true;
+    requestedWrites++;
+}
+
+
+bool WriteBackScheduler::isDirty() const
+{
+    return isDirtyFlag;
+}
+
+
+bool WriteBackScheduler::flush()
+{
+    bool isFlushed = !isDirtyFlag;
+
+    if (isDirtyFlag && writeFunction && writeFunction())
+    {
+        isDirtyFlag = false;
+        isFlushed = true;
+        performedWrites++;
+    }
+
+    return isFlushed;
+}
+
+
+uint64_t WriteBackScheduler::getRequestedWrites() const
+{
+    return requestedWrites;
+}
+
+
+uint64_t WriteBackScheduler::getPerformedWrites() const
+{
+    return performedWrites;
+}
+
+
+uint64_t WriteBackScheduler::getCoalescedWrites() const
+{
+    return coalescedWrites;
+}
+
+
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the 'MSI Afterburner Profile Loader'
+ * (https://github.com/ThatUsernameAlreadyExist/msiafterburnerloader).
+ * Copyright (c) Alexander P
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTILS_WRITE_BACK_SCHEDULER_H__
+#define __UTILS_WRITE_BACK_SCHEDULER_H__
+
+
+#include <cstdint>
+#include <functional>
+
+
+namespace Loader
+{
+
+// Collects write requests and performs a single write for the whole burst.
+// Owner is responsible for calling 'flush' after 'getQuietPeriod' milliseconds
+// without new requests (for example with a restarted window timer) and on shutdown.
+class WriteBackScheduler
+{
+public:
+    typedef std::function<bool()> WriteFunction;
+
+    WriteBackScheduler(uint32_t quietPeriodMs, const WriteFunction &writeFunction);
+    WriteBackScheduler(const WriteBackScheduler&) = delete;
+    WriteBackScheduler &operator=(const WriteBackScheduler&) = delete;
+
+    void setQuietPeriod(uint32_t quietPeriodMs);
+    uint32_t getQuietPeriod() const;
+
+    void markDirty();
+    bool isDirty() const;
+    bool flush();
+
+    uint64_t getRequestedWrites() const;
+    uint64_t getPerformedWrites() const;
+    uint64_t getCoalescedWrites() const; // Requests made while a write was already pending.
+
+private:
+    WriteFunction writeFunction;
+    uint32_t quietPeriodMs;
+    bool isDirtyFlag;
+    uint64_t requestedWrites;
+    uint64_t performedWrites;
+    uint64_t coalescedWrites;
+};
+
+}
+
+
+#endif